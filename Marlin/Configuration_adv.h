@@ -877,6 +877,65 @@
 // if unwanted behavior is observed on a user's machine when running at very slow speeds.
 #define MINIMUM_PLANNER_SPEED 0.05 // (mm/s)
 
+// Compute block trapezoids (step rates, accel/decel steps, S-curve times) with
+// integer / fixed-point math instead of float, for MCUs without an FPU like the
+// LPC1768 (Cortex-M3). Only the trapezoid step is converted. Junction speeds and
+// the entry/exit factors are still float. The LINUX replay report compares the
+// results and cycles of both with PLANNER_FIXED_POINT_CHECK.
+//#define PLANNER_FIXED_POINT
+#if ENABLED(PLANNER_FIXED_POINT)
+  //#define PLANNER_FIXED_POINT_CHECK // Also run the float math, track the largest difference and the cycles of both
+#endif
+
+/**
+ * Segment Coalescing
+ *
+ * Fuse runs of short, nearly collinear G1 moves (e.g., from high resolution
+ * STL exports) into a single planner block. A segment is merged when its
+ * direction changes less than the angle tolerance, every merged point stays
+ * within the chord tolerance of the combined move, and the feedrate and
+ * extrusion per mm match. Use M230 to set the tolerances and report counters.
+ */
+//#define SEGMENT_COALESCING
+#if ENABLED(SEGMENT_COALESCING)
+  #define COALESCE_MAX_SEGMENT_MM   1.0   // (mm) Only segments shorter than this are merged
+  #define COALESCE_CHORD_TOLERANCE  0.01  // (mm) Max distance of a merged point from the combined move
+  #define COALESCE_ANGLE_TOLERANCE  3     // (°) Max direction change between merged segments
+  #define COALESCE_E_TOLERANCE      0.02  // Max relative difference of extrusion per mm
+  #define COALESCE_MAX_SEGMENTS     8     // Max segments fused into one block
+  #define COALESCE_HOLD_MS          50    // (ms) Deliver a held segment after this time
+#endif
+
+/**
+ * Input Shaping
+ *
+ * Reduce ringing (ghosting) by splitting every X and Y step into impulses timed
+ * to cancel the frame resonance. ZV is the shortest shaper. ZVD and EI tolerate
+ * a less precise frequency at the cost of more smoothing.
+ *
+ * Print a ringing tower made with buildroot/share/scripts/ringing_test.py and
+ * read off the frequency of the ripples behind the corners, or the band where
+ * they disappear. Use M593 to set the shaper at runtime. (Cartesian only.)
+ *
+ * Shaping is paused for G28 and G425, where endstops stop the axes. Z probing
+ * is unaffected since Z isn't shaped. An endstop hit during a shaped move
+ * (ENDSTOPS_ALWAYS_ON_DEFAULT, SD_ABORT_ON_ENDSTOP_HIT) stops the axes after
+ * the impulses already queued, up to one resonance period late.
+ * M593 waits for all moves to finish before it changes the shaper.
+ */
+//#define INPUT_SHAPING
+#if ENABLED(INPUT_SHAPING)
+  #define SHAPING_TYPE        SHAPER_ZV // SHAPER_ZV, SHAPER_ZVD or SHAPER_EI
+  #define SHAPING_FREQ_X      40        // (Hz) X resonance. 0 to disable.
+  #define SHAPING_FREQ_Y      40        // (Hz) Y resonance. 0 to disable.
+  #define SHAPING_ZETA_X      0.1f      // X damping ratio (0..0.5)
+  #define SHAPING_ZETA_Y      0.1f      // Y damping ratio (0..0.5)
+  #define SHAPING_MIN_FREQ    10        // (Hz) Lowest frequency allowed by M593
+  #define SHAPING_MAX_FREQ    200       // (Hz) Highest frequency allowed by M593
+  #define SHAPING_BUFFER_SIZE 512       // Step events waiting on their impulses, per axis. Must hold
+                                        // (max step rate / min frequency) events to shape every step.
+#endif
+
 //
 // Backlash Compensation
 // Adds extra movement to axes on direction-changes to account for backlash.
@@ -1152,6 +1211,33 @@
   #define SD_FINISHED_STEPPERRELEASE true   // Disable steppers when SD Print is finished
   #define SD_FINISHED_RELEASECOMMAND "M84"  // Use "M84XYE" to keep Z enabled so your bed stays in place
 
+  // Read the printed file a whole 512-byte block at a time into two buffers,
+  // taking lines straight out of them, and read the next block while the
+  // command queue is full. Costs 1K of RAM.
+  //#define SD_READ_AHEAD
+
+  // Read the blocks of a file that follow on from one multi-block read (CMD18)
+  // kept open between reads, instead of a command and response per block.
+  // A seek, a write, any other card access or a gap between clusters ends it.
+  // Best with SD_READ_AHEAD, which reads whole blocks. (SD cards on SPI only.)
+  //#define SD_MULTIBLOCK_READ
+
+  // Keep the runs of clusters of the file being printed, found by walking the
+  // FAT once when it's opened. Reads don't go back to the FAT between blocks,
+  // so the one block cache keeps the data, and a seek (M26, power-loss resume)
+  // is a lookup instead of a walk down the chain. A file in more runs than
+  // this walks the FAT after the last one. 8 bytes of RAM per run.
+  //#define SD_FILE_EXTENTS 4
+
+  // Write blocks to the card from idle(), one at a time, instead of waiting
+  // for each one in the write (M28, binary transfer, power-loss saves, SD
+  // EEPROM). A file's close or sync waits for all of its blocks. 516 bytes
+  // of RAM per block.
+  //#define SD_WRITE_BEHIND
+  #if ENABLED(SD_WRITE_BEHIND)
+    #define SD_WRITE_BEHIND_BLOCKS 4        // Blocks waiting before a write has to wait for the card
+  #endif
+
   // Reverse SD sort to show "more recent" files first, according to the card's FAT.
   // Since the FAT gets out of order with usage, SDCARD_SORT_ALPHA is recommended.
   #define SDCARD_RATHERRECENTFIRST
@@ -1194,6 +1280,15 @@
     // Without a POWER_LOSS_PIN the following option helps reduce wear on the SD card,
     // especially with "vase mode" printing. Set too high and vases cannot be continued.
     #define POWER_LOSS_MIN_Z_CHANGE 0.05 // (mm) Minimum Z change before saving power-loss data
+
+    // Keep the power-loss data in a journal, a contiguous file made at the first
+    // save of a print and kept open. Each save writes one block of it, the next
+    // record in turn, numbered and with a CRC, and never the FAT or the directory.
+    // The newest good record is used to resume, so a save cut off loses nothing.
+    //#define POWER_LOSS_JOURNAL
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      #define POWER_LOSS_JOURNAL_SLOTS 16 // Records in the journal, a 512-byte block each
+    #endif
   #endif
 
   /**
@@ -1807,6 +1902,7 @@
   #define N_ARC_CORRECTION       25 // Number of interpolated segments between corrections
   //#define ARC_P_CIRCLES           // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES    // Allow G2/G3 to operate in XY, ZX, or YZ planes
+  //#define ARC_BLOCKS              // Queue XY arcs as a few arc blocks traced by the Stepper instead of many segments
 #endif
 
 // Support for G5 with XYZE destination and IJPQ offsets. Requires ~2666 bytes.
@@ -1902,9 +1998,15 @@
   #define BLOCK_BUFFER_SIZE 16
 #endif
 
+// Replan only this many of the newest blocks when a block is added, so a deep
+// buffer doesn't make planning slower. This is also the look-ahead distance.
+//#define PLANNER_WINDOW_SIZE 32
+
 // @section serial
 
 // The ASCII buffer for serial input
+// The command queue takes BUFSIZE * MAX_CMD_SIZE bytes. Commands are packed
+// by length, so it holds more than BUFSIZE of the usual short G1 commands.
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 32
 
@@ -1932,6 +2034,19 @@
 // Add M575 G-code to change the baud rate
 //#define BAUD_RATE_GCODE
 
+/**
+ * Binary Motion Protocol
+ *
+ * Stream moves as compact binary frames instead of text lines. The host sends
+ * "M576 S1" and then frames of delta-encoded G0/G1 records with a line number
+ * and CRC16. Many more moves per second fit through the same baud rate.
+ * See buildroot/share/scripts/binary_motion.py for an encoder.
+ */
+//#define BINARY_MOTION_PROTOCOL
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+  #define BINARY_MOTION_FRAME_SIZE 64   // (bytes) Largest frame payload. 16-250. Each serial port uses ~this much RAM.
+#endif
+
 #if ENABLED(SDSUPPORT)
   // Enable this option to collect and display the maximum
   // RX queue usage after transferring a file to SD.
@@ -1961,6 +2076,24 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+/**
+ * Selective Resend
+ *
+ * For hosts that keep several numbered lines in flight. After a bad or lost
+ * line the lines behind it are held rather than thrown away, and "Resend:"
+ * asks only for the missing line. Every line sent still gets one "ok", and a
+ * line that was already received is answered "ok" (with its N for ADVANCED_OK)
+ * without running it again.
+ *
+ * The host may have up to RESEND_WINDOW lines waiting for their "ok". A line
+ * further ahead of the missing one is an error and is asked for again.
+ * buildroot/share/scripts/selective_resend_test.py checks it in the simulator.
+ */
+//#define SELECTIVE_RESEND
+#if ENABLED(SELECTIVE_RESEND)
+  #define RESEND_WINDOW 4   // Lines held while waiting for a resend. 2-32. Each takes MAX_CMD_SIZE bytes of RAM per serial port.
+#endif
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -3191,6 +3324,8 @@
 
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+  //#define PREPARSED_COMMANDS    // Parse commands as they are queued, not when they run. Each
+                                  // parameter takes 5 more bytes in the command queue.
 #endif
 
 //#define GCODE_CASE_INSENSITIVE  // Accept G-code sent to the firmware in lowercase
@@ -3574,6 +3709,17 @@
 //
 #define M100_FREE_MEMORY_WATCHER
 
+//
+// M124 - Profile the Stepper ISR phases in CPU cycles (min/avg/max and histogram)
+// Requires a HAL cycle counter (LPC1768 DWT, LINUX x86 TSC)
+//
+//#define STEPPER_ISR_PROFILER
+
+//
+// M101 - Count the calls and time spent per G-code (e.g., to see which commands dominate a print)
+//
+//#define GCODE_PROFILER
+
 //
 // M43 - display pin status, toggle pins, watch pins, watch endstops & toggle LED, test servo probe
 //
@@ -78,4 +78,25 @@ void HAL_pwm_init() {
 
 }
 
+#ifdef HAL_CYCLE_COUNTER
+
+  #include <chrono>
+  #include <thread>
+
+  // Time stamp counter ticks per second, measured once against the host clock
+  uint32_t HAL_cycle_frequency() {
+    static uint32_t hz = 0;
+    if (!hz) {
+      const auto t0 = std::chrono::steady_clock::now();
+      const uint64_t c0 = __rdtsc();
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      const uint64_t c1 = __rdtsc();
+      const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+      hz = uint32_t(_MIN((c1 - c0) / s, double(UINT32_MAX)));  // Hosts past 4.29GHz read low
+    }
+    return hz;
+  }
+
+#endif
+
 #endif // __PLAT_LINUX__
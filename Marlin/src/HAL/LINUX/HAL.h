@@ -79,6 +79,10 @@ extern HalSerial usb_serial;
 
 inline void HAL_init() {}
 
+// HAL idle task, drives the simulation in virtual time
+#define HAL_IDLETASK 1
+void HAL_idletask();
+
 // Utility functions
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -98,6 +102,16 @@ void HAL_adc_enable_channel(const uint8_t ch);
 void HAL_adc_start_conversion(const uint8_t ch);
 uint16_t HAL_adc_get_result();
 
+// Host time stamp counter, for profiling
+#if defined(__i386__) || defined(__x86_64__)
+  #include <x86intrin.h>
+  #define HAL_CYCLE_COUNTER 1
+  inline void HAL_cycle_counter_init() {}
+  FORCE_INLINE static uint32_t HAL_cycle_count() { return (uint32_t)__rdtsc(); }
+  uint32_t HAL_cycle_frequency();
+  #define HAL_CYCLE_FREQUENCY HAL_cycle_frequency()   // Not F_CPU, the simulated MCU clock
+#endif
+
 // Reset source
 inline void HAL_clear_reset_source(void) {}
 inline uint8_t HAL_get_reset_source(void) { return RST_POWER_ON; }
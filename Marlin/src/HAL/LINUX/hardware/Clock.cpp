@@ -23,9 +23,20 @@
 
 #include "../../../inc/MarlinConfig.h"
 #include "Clock.h"
+#include "Timer.h"
 
 std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::now().time_since_epoch();
 uint32_t Clock::frequency = F_CPU;
 double Clock::time_multiplier = 1.0;
+bool Clock::virtual_time = false;
+uint64_t Clock::virtual_nanos = 0;
+
+void Clock::advance(uint64_t ns) {
+  // A delay inside an ISR only makes the ISR take longer, nothing may preempt it
+  if (Timer::inISR())
+    Clock::advanceTo(Clock::virtual_nanos + ns);
+  else
+    Timer::runUntil(Clock::virtual_nanos + ns);
+}
 
 #endif // __PLAT_LINUX__
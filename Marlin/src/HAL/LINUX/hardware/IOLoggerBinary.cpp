@@ -0,0 +1,142 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "IOLoggerBinary.h"
+#include <chrono>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+IOLoggerBinary::IOLoggerBinary(std::string filename, std::initializer_list<TraceAxis> axes) {
+  for (uint32_t i = 0; i < ring_size; i++) ring[i].sequence.store(i, std::memory_order_relaxed);
+  ring_head = 0;
+  ring_tail = 0;
+  dropped = 0;
+  header = nullptr;
+  chunk = nullptr;
+  chunk_offset = chunk_used = 0;
+  running = false;
+
+  fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || ftruncate(fd, header_size) != 0) return;
+  void *map = mmap(nullptr, header_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) return;
+
+  header = (TraceHeader*)map;
+  memcpy(header->magic, "MLNTRACE", sizeof(header->magic));
+  header->version = 1;
+  header->record_size = sizeof(TraceRecord);
+  for (const TraceAxis &axis : axes) {
+    if (header->axis_count >= TraceHeader::max_axes) break;
+    auto &a = header->axes[header->axis_count++];
+    a.name = axis.name;
+    a.step_pin = axis.step_pin;
+    a.dir_pin = axis.dir_pin;
+    a.enable_pin = axis.enable_pin;
+  }
+
+  if (!map_chunk(header_size)) return;
+  running = true;
+  drain_thread = std::thread(&IOLoggerBinary::drain, this);
+}
+
+IOLoggerBinary::~IOLoggerBinary() {
+  if (running) {
+    running = false;
+    drain_thread.join();
+  }
+  if (chunk) munmap(chunk, chunk_size);
+  if (header) {
+    header->dropped = dropped;
+    if (fd >= 0 && ftruncate(fd, header_size + header->record_count * sizeof(TraceRecord)) != 0) { /* keep the padded file */ }
+    munmap(header, header_size);
+  }
+  if (fd >= 0) close(fd);
+}
+
+// Bounded lock-free ring with per-slot sequence numbers (D. Vyukov)
+void IOLoggerBinary::log(GpioEvent ev) {
+  uint32_t pos = ring_head.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &ring[pos & (ring_size - 1)];
+    const int32_t diff = (int32_t)(slot->sequence.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (ring_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    }
+    else if (diff < 0) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else
+      pos = ring_head.load(std::memory_order_relaxed);
+  }
+  slot->record.timestamp = ev.timestamp;
+  slot->record.pin = ev.pin_id;
+  slot->record.value = Gpio::pin_map[ev.pin_id].value;
+  slot->record.event = ev.event;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void IOLoggerBinary::drain() {
+  for (;;) {
+    const bool stopping = !running;
+    uint32_t count = 0;
+    for (;;) {
+      Slot &slot = ring[ring_tail & (ring_size - 1)];
+      if (slot.sequence.load(std::memory_order_acquire) != ring_tail + 1) break;
+      write(slot.record);
+      slot.sequence.store(ring_tail + ring_size, std::memory_order_release);
+      ring_tail++;
+      count++;
+    }
+    if (count) header->dropped = dropped;
+    else if (stopping) break;
+    else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+bool IOLoggerBinary::map_chunk(size_t offset) {
+  if (chunk) munmap(chunk, chunk_size);
+  chunk = nullptr;
+  if (ftruncate(fd, offset + chunk_size) != 0) return false;
+  void *map = mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+  if (map == MAP_FAILED) return false;
+  chunk = (uint8_t*)map;
+  chunk_offset = offset;
+  chunk_used = 0;
+  return true;
+}
+
+void IOLoggerBinary::write(const TraceRecord &record) {
+  if (chunk_used + sizeof(TraceRecord) > chunk_size && !map_chunk(chunk_offset + chunk_size)) {
+    dropped++;
+    return;
+  }
+  memcpy(chunk + chunk_used, &record, sizeof(TraceRecord));
+  chunk_used += sizeof(TraceRecord);
+  header->record_count++; // the header page is shared, so a killed simulator still leaves a readable file
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,96 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include "Gpio.h"
+
+/**
+ * Binary GPIO trace recorder
+ *
+ * log() is lock-free and only copies a fixed-size record into a ring, so it
+ * is safe to call from the timer signal handlers even when they interrupt
+ * another log(). A background thread drains the ring into a memory-mapped
+ * file. If the ring overflows records are dropped and counted, never waited for.
+ *
+ * File layout: one page holding TraceHeader, then record_count TraceRecords.
+ * Decode with buildroot/share/scripts/decode_gpio_trace.py
+ */
+
+struct TraceAxis {
+  char name;
+  pin_type step_pin, dir_pin, enable_pin;
+};
+
+struct TraceRecord {
+  uint64_t timestamp;
+  int16_t pin;
+  uint16_t value;
+  uint8_t event;
+  uint8_t reserved[3];
+};
+
+struct TraceHeader {
+  static const uint8_t max_axes = 8;
+  char magic[8];                // "MLNTRACE"
+  uint32_t version, record_size;
+  uint64_t record_count, dropped;
+  uint32_t axis_count, reserved;
+  struct { char name; uint8_t reserved; int16_t step_pin, dir_pin, enable_pin; } axes[max_axes];
+};
+
+class IOLoggerBinary: public IOLogger {
+public:
+  IOLoggerBinary(std::string filename, std::initializer_list<TraceAxis> axes);
+  virtual ~IOLoggerBinary();
+  void log(GpioEvent ev);
+
+private:
+  static const uint32_t ring_size = 1UL << 16; // must be a power of 2
+  static const size_t header_size = 4096;
+  static const size_t chunk_size = 16UL << 20;
+
+  struct Slot {
+    std::atomic<uint32_t> sequence;
+    TraceRecord record;
+  };
+
+  void drain();
+  bool map_chunk(size_t offset);
+  void write(const TraceRecord &record);
+
+  Slot ring[ring_size];
+  std::atomic<uint32_t> ring_head; // producers
+  uint32_t ring_tail;              // drain thread only
+  std::atomic<uint64_t> dropped;
+
+  int fd;
+  TraceHeader *header;
+  uint8_t *chunk;
+  size_t chunk_offset, chunk_used;
+
+  std::atomic<bool> running;
+  std::thread drain_thread;
+};
@@ -54,7 +54,9 @@ void LinearAxis::interrupt(GpioEvent ev) {
   if (ev.pin_id == step_pin && !Gpio::pin_map[enable_pin].value){
     if (ev.event == GpioEvent::RISE) {
       last_update = ev.timestamp;
-      position += -1 + 2 * Gpio::pin_map[dir_pin].value;
+      const int8_t dir = -1 + 2 * Gpio::pin_map[dir_pin].value;
+      position += dir;
+      if (resonator) resonator->step(ev.timestamp, dir);
       Gpio::pin_map[min_pin].value = (position < min_position);
       //Gpio::pin_map[max_pin].value = (position > max_position);
       //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include "Gpio.h"
+#include "Resonator.h"
 
 class LinearAxis: public Peripheral {
 public:
@@ -41,5 +42,6 @@ public:
   int32_t min_position;
   int32_t max_position;
   uint64_t last_update;
+  Resonator *resonator = nullptr;        // Optional carriage vibration model
 
 };
@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <math.h>
+#include "Resonator.h"
+
+double Resonator::frequency = 0,
+       Resonator::zeta = 0.05;
+
+Resonator x_resonator, y_resonator;
+
+// Let the carriage swing freely for dt seconds
+void Resonator::advance(const double dt) {
+  const double w = 2 * M_PI * frequency,
+               s = zeta * w,
+               wd = w * sqrt(1 - zeta * zeta),
+               A = position,
+               B = (velocity + s * position) / wd,
+               decay = exp(-s * dt),
+               c = cos(wd * dt), n = sin(wd * dt);
+  position = decay * (A * c + B * n);
+  velocity = decay * ((wd * B - s * A) * c - (wd * A + s * B) * n);
+}
+
+// Peak of the free swing from here on
+double Resonator::amplitude() const {
+  const double w = 2 * M_PI * frequency,
+               wd = w * sqrt(1 - zeta * zeta),
+               B = (velocity + zeta * w * position) / wd;
+  return sqrt(position * position + B * B);
+}
+
+void Resonator::step(const uint64_t timestamp, const int8_t dir) {
+  const double dt = (timestamp - last_step) / 1000000000.0;
+  if (moving && dt * frequency > 2) finish();
+  if (last_step) advance(dt);
+  position -= dir;      // The motor moved. The carriage catches up through the spring.
+  residual = amplitude();
+  last_step = timestamp;
+  moving = true;
+}
+
+void Resonator::finish() {
+  if (!moving) return;
+  moving = false;
+  stops++;
+  total_residual += residual;
+  if (residual > max_residual) max_residual = residual;
+}
+
+#endif // __PLAT_LINUX__
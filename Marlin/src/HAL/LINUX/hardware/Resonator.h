@@ -0,0 +1,55 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * A carriage on a spring, to see how much an axis rings after it stops.
+ *
+ * Each step moves the motor end of the spring, and the carriage lags behind
+ * as a damped oscillator. Whenever the axis rests for a few periods, the
+ * swing it was left with is recorded as the residual vibration of that stop.
+ * Amplitudes are in steps.
+ */
+class Resonator {
+public:
+  static double frequency, zeta;            // Shared by both axes. Set with --resonance.
+  static bool enabled() { return frequency > 0; }
+
+  void step(const uint64_t timestamp, const int8_t dir);
+  void finish();                            // Count the last stop too
+
+  uint32_t stops = 0;
+  double max_residual = 0, total_residual = 0;
+
+private:
+  void advance(const double dt);
+  double amplitude() const;
+
+  double position = 0, velocity = 0;        // Carriage relative to the motor, in steps and steps/s
+  double residual = 0;                      // Amplitude left by the last step
+  uint64_t last_step = 0;
+  bool moving = false;
+};
+
+extern Resonator x_resonator, y_resonator;
@@ -24,6 +24,10 @@
 #include "Timer.h"
 #include <stdio.h>
 
+Timer* Timer::instances[Timer::max_timers] = {};
+uint8_t Timer::instance_count = 0;
+Timer* Timer::current = nullptr;
+
 Timer::Timer() {
   active = false;
   compare = 0;
@@ -34,10 +38,11 @@ Timer::Timer() {
   period = 0;
   start_time = 0;
   avg_error = 0;
+  next_fire = 0;
 }
 
 Timer::~Timer() {
-  timer_delete(timerid);
+  if (!Clock::isVirtualTime()) timer_delete(timerid);
 }
 
 void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
@@ -47,6 +52,13 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (Clock::isVirtualTime()) {
+    // Driven by runNext / runUntil instead of a POSIX timer
+    if (instance_count < max_timers) instances[instance_count++] = this;
+    active = false;
+    return;
+  }
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -73,6 +85,7 @@ void Timer::start(uint32_t frequency) {
 }
 
 void Timer::enable() {
+  if (Clock::isVirtualTime()) { active = true; return; }
   if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -81,6 +94,7 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
+  if (Clock::isVirtualTime()) { active = false; return; }
   if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -88,6 +102,14 @@ void Timer::disable() {
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (Clock::isVirtualTime()) {
+    // Inside its own ISR the counter restarted at the match, elsewhere it restarts now
+    if (current != this) this->start_time = Clock::nanos();
+    this->compare = compare;
+    this->next_fire = this->start_time + Clock::ticksToNanos(compare ? compare : 1, frequency);
+    return;
+  }
+
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -111,7 +133,43 @@ void Timer::setCompare(uint32_t compare) {
 }
 
 uint32_t Timer::getCount() {
+  // Reading the counter costs one tick in virtual time, so busy-waits on it terminate
+  if (Clock::isVirtualTime()) Clock::advanceTo(Clock::nanos() + Clock::ticksToNanos(1, frequency));
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
 
+Timer* Timer::nextDue() {
+  Timer* next = nullptr;
+  for (uint8_t i = 0; i < instance_count; i++) {
+    Timer* t = instances[i];
+    if (t->active && (next == nullptr || t->next_fire < next->next_fire)) next = t;
+  }
+  return next;
+}
+
+void Timer::dispatch() {
+  Clock::advanceTo(next_fire);
+  start_time = next_fire;                                        // the match restarts the counter, whatever the latency
+  next_fire = start_time + Clock::ticksToNanos(compare ? compare : 1, frequency); // periodic unless the ISR sets a new compare
+  current = this;
+  cbfn();
+  current = nullptr;
+}
+
+bool Timer::runNext() {
+  if (inISR()) return false;
+  Timer* next = nextDue();
+  if (next == nullptr) return false;
+  next->dispatch();
+  return true;
+}
+
+void Timer::runUntil(uint64_t ns) {
+  if (!inISR()) {
+    for (Timer* next = nextDue(); next != nullptr && next->next_fire <= ns; next = nextDue())
+      next->dispatch();
+  }
+  Clock::advanceTo(ns);
+}
+
 #endif // __PLAT_LINUX__
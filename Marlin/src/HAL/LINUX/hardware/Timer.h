@@ -62,7 +62,20 @@ public:
                                                          // using a realtime linux kernel would help somewhat
   }
 
+  // Virtual time scheduler, see Clock::setVirtualTime
+  static bool runNext();                   // Jump to the earliest pending timer event and run it
+  static void runUntil(uint64_t ns);       // Run every timer event due up to ns, then advance the clock to ns
+  static bool inISR() { return current != nullptr; }
+
 private:
+  static Timer* nextDue();
+  void dispatch();
+
+  static const uint8_t max_timers = 4;
+  static Timer* instances[max_timers];
+  static uint8_t instance_count;
+  static Timer* current;
+
   bool active;
   uint32_t compare;
   uint32_t frequency;
@@ -73,4 +86,5 @@ private:
   uint64_t period;
   uint64_t avg_error;
   uint64_t start_time;
+  uint64_t next_fire;
 };
@@ -29,6 +29,8 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include "../serial_io.h"
+
 /**
  * Generic RingBuffer
  * T type of the buffer array
@@ -92,12 +94,18 @@ public:
     return receive_buffer.peek(&value) ? value : -1;
   }
 
-  int read() { return receive_buffer.read(); }
+  int read() {
+    const int c = receive_buffer.read();
+    if (c >= 0) SerialIO::rxConsumed();
+    return c;
+  }
 
   size_t write(char c) {
     if (!host_connected) return 0;
-    while (!transmit_buffer.free());
-    return transmit_buffer.write(c);
+    while (!transmit_buffer.free()) SerialIO::waitTxSpace();
+    if (!transmit_buffer.write(c)) return 0;
+    SerialIO::txWritten();
+    return 1;
   }
 
   operator bool() { return host_connected; }
@@ -113,8 +121,7 @@ public:
   }
 
   void flushTX() {
-    if (host_connected)
-      while (transmit_buffer.available()) { /* nada */ }
+    if (host_connected) SerialIO::waitTxEmpty();
   }
 
   void printf(const char *format, ...) {
@@ -124,13 +131,7 @@ public:
     int length = vsnprintf((char *) buffer, 256, (char const *) format, vArgs);
     va_end(vArgs);
     if (length > 0 && length < 256) {
-      if (host_connected) {
-        for (int i = 0; i < length;) {
-          if (transmit_buffer.write(buffer[i])) {
-            ++i;
-          }
-        }
-      }
+      for (int i = 0; i < length; i++) write(buffer[i]);
     }
   }
 
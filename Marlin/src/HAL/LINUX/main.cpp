@@ -22,90 +22,223 @@
 extern void setup();
 extern void loop();
 
+#include <chrono>
 #include <thread>
 
 #include <iostream>
-#include <fstream>
 
 #include "../../inc/MarlinConfig.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include <poll.h>
+#include <unistd.h>
 #include "../shared/Delay.h"
-#include "hardware/IOLoggerCSV.h"
+#include "../../gcode/queue.h"
+#include "../../sd/cardreader.h"
+#include "hardware/IOLoggerBinary.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "hardware/Timer.h"
+#include "replay.h"
+#include "parser_test.h"
+#include "sd_test.h"
+#include "serial_io.h"
 
-// simple stdout / stdin implementation for fake serial port
-void write_serial_thread() {
-  for (;;) {
-    for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
-      fputc(usb_serial.transmit_buffer.read(), stdout);
-    }
-    std::this_thread::yield();
+// Non-blocking stdin reader for virtual time, runs on the firmware thread.
+// Redirect stdin from a file to get the same input timing on every run.
+void poll_serial() {
+  static bool eof = false;
+  if (eof) return;
+  pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+  while (usb_serial.receive_buffer.free() && poll(&pfd, 1, 0) > 0) {
+    uint8_t buffer[128];
+    const ssize_t len = read(STDIN_FILENO, buffer, _MIN(usb_serial.receive_buffer.free(), sizeof(buffer)));
+    if (len <= 0) { eof = true; break; }
+    for (ssize_t i = 0; i < len; i++)
+      usb_serial.receive_buffer.write(buffer[i]);
   }
 }
 
-void read_serial_thread() {
-  char buffer[255] = {};
-  for (;;) {
-    std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
-      for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
-    std::this_thread::yield();
+//#define GPIO_LOGGING // Full GPIO trace, see buildroot/share/scripts/decode_gpio_trace.py
+
+// Simulated printer hardware attached to the GPIO pins
+class Simulation {
+public:
+  Simulation() :
+    hotend(HEATER_0_PIN, TEMP_0_PIN),
+    bed(HEATER_BED_PIN, TEMP_BED_PIN),
+    x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN),
+    y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN),
+    z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN),
+    extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC)
+    #ifdef GPIO_LOGGING
+      , logger("gpio_trace.bin", {
+          { 'X', X_STEP_PIN, X_DIR_PIN, X_ENABLE_PIN },
+          { 'Y', Y_STEP_PIN, Y_DIR_PIN, Y_ENABLE_PIN },
+          { 'Z', Z_STEP_PIN, Z_DIR_PIN, Z_ENABLE_PIN },
+          { 'E', E0_STEP_PIN, E0_DIR_PIN, E0_ENABLE_PIN }
+        })
+    #endif
+  {
+    #ifdef GPIO_LOGGING
+      Gpio::attachLogger(&logger);
+    #endif
+    if (Resonator::enabled()) {
+      x_axis.resonator = &x_resonator;
+      y_axis.resonator = &y_resonator;
+    }
   }
-}
 
-void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+  void update() {
+    hotend.update();
+    bed.update();
 
-  //#define GPIO_LOGGING // Full GPIO and Positional Logging
+    x_axis.update();
+    y_axis.update();
+    z_axis.update();
+    extruder0.update();
+  }
+
+  Heater hotend, bed;
+  LinearAxis x_axis, y_axis, z_axis, extruder0;
 
   #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
+    IOLoggerBinary logger;
+  #endif
+};
 
-    std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
+Simulation* simulation = nullptr;
+Timer simulation_timer;
 
-    int32_t x,y,z;
-  #endif
+void simulation_tick() {
+  simulation->update();
+}
 
+// Wall-clock mode: update the hardware at 10kHz. Steppers and endstops
+// are driven by GPIO interrupts, so only the heaters need polling.
+void simulation_loop() {
+  Simulation sim;
+  auto next = std::chrono::steady_clock::now();
   for (;;) {
+    sim.update();
+    next += std::chrono::microseconds(100);
+    std::this_thread::sleep_until(next);
+  }
+}
 
-    hotend.update();
-    bed.update();
+// Set before each loop(), whose first idle() is the main loop's own
+static bool main_loop_idle = false;
 
-    x_axis.update();
-    y_axis.update();
-    z_axis.update();
-    extruder0.update();
+// HAL idle task
+void HAL_idletask() {
+  if (Clock::isVirtualTime()) {
+    // The firmware runs in zero time between events:
+    // take the serial input and jump to the next timer event.
+    if (Replay::active())
+      Replay::idle();
+    else
+      poll_serial();
+    Timer::runNext();
+    return;
+  }
 
-    #ifdef GPIO_LOGGING
-      if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = MAX3(x_axis.last_update, y_axis.last_update, z_axis.last_update);
-        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
-        position_log.flush();
-        x = x_axis.position;
-        y = y_axis.position;
-        z = z_axis.position;
+  // Wall-clock time: sleep instead of spinning. The timer ISRs keep running.
+  // With no commands to run the main loop sleeps until input arrives, but
+  // never past the next millisecond, so heater control, thermal protection
+  // and the inactivity timeouts in idle() keep their pace. A command waiting
+  // on the printer (planner full, heating, dwell) also sleeps a millisecond.
+  if (main_loop_idle) {
+    main_loop_idle = false;
+    if (queue.has_commands_queued() || IS_SD_PRINTING()) return;
+    SerialIO::waitRx(1000);             // µs
+  }
+  else
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void usage(const char *name) {
+  fprintf(stderr, "Usage: %s [options]\n"
+                  "  --virtual-time   Run in deterministic virtual time instead of wall-clock time\n"
+                  "  --replay <file>  Run a G-code file in virtual time, report and exit when done\n"
+                  "  --report <file>  Write the replay report to a file instead of stderr\n"
+                  "  --serial <port>  Host connection: stdio (default), pty[:<link>] or tcp:<port>\n"
+                  "  --resonance <hz>[,<zeta>]  Model X and Y as carriages on springs and report their ringing\n"
+                  "  --test-parser [<count>]  Check the G-code number scanners against the C library and exit\n"
+                  #if ENABLED(SDSUPPORT)
+                    "  --sd-image <file>  Use a disk image as the SD card (see make_sd_image.py)\n"
+                    "  --sd-timing <command_us>,<block_us>[,<busy_us>]  Make the SD card take as long as a real one\n"
+                    "  --sd-errors <one_in>[,<seed>]  Fail about one SD block in <one_in>\n"
+                    "  --test-sd <path>  Time reads of a file on the SD image in virtual time and exit\n"
+                  #endif
+                  , name);
+}
+
+int main(int argc, char *argv[]) {
+  const char *replay_file = nullptr, *report_file = nullptr, *serial_port = nullptr, *test_sd = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--virtual-time"))
+      Clock::setVirtualTime(true);
+    else if (!strcmp(argv[i], "--replay") && i + 1 < argc)
+      replay_file = argv[++i];
+    else if (!strcmp(argv[i], "--report") && i + 1 < argc)
+      report_file = argv[++i];
+    else if (!strcmp(argv[i], "--serial") && i + 1 < argc)
+      serial_port = argv[++i];
+    else if (!strcmp(argv[i], "--test-parser"))
+      return ParserTest::run(i + 1 < argc ? strtoul(argv[++i], nullptr, 10) : 1000000);
+    #if ENABLED(SDSUPPORT)
+      else if (!strcmp(argv[i], "--sd-image") && i + 1 < argc)
+        Sd2Card::image = argv[++i];
+      else if (!strcmp(argv[i], "--sd-timing") && i + 1 < argc) {
+        if (sscanf(argv[++i], "%u,%u,%u", &Sd2Card::timing.command_us, &Sd2Card::timing.block_us, &Sd2Card::timing.busy_us) < 2) {
+          usage(argv[0]);
+          return 1;
+        }
       }
-      // flush the logger
-      logger.flush();
+      else if (!strcmp(argv[i], "--sd-errors") && i + 1 < argc) {
+        if (sscanf(argv[++i], "%u,%u", &Sd2Card::errors.one_in, &Sd2Card::errors.seed) < 1) {
+          usage(argv[0]);
+          return 1;
+        }
+      }
+      else if (!strcmp(argv[i], "--test-sd") && i + 1 < argc)
+        test_sd = argv[++i];
     #endif
+    else if (!strcmp(argv[i], "--resonance") && i + 1 < argc) {
+      if (sscanf(argv[++i], "%lf,%lf", &Resonator::frequency, &Resonator::zeta) < 1 || Resonator::frequency <= 0 || !WITHIN(Resonator::zeta, 0, 0.99)) {
+        usage(argv[0]);
+        return 1;
+      }
+    }
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
 
-    std::this_thread::yield();
+  if (test_sd) {
+    Clock::setVirtualTime(true);
+    return TERN(SDSUPPORT, SDTest::run(test_sd), 1);
   }
-}
 
-int main() {
-  std::thread write_serial (write_serial_thread);
-  std::thread read_serial (read_serial_thread);
+  if (replay_file) {
+    if (!Replay::open(replay_file, report_file)) {
+      fprintf(stderr, "Can't open %s\n", replay_file);
+      return 1;
+    }
+    Clock::setVirtualTime(true);
+  }
+
+  // Virtual time reads stdin on the firmware thread to stay deterministic
+  if (serial_port && Clock::isVirtualTime()) {
+    fprintf(stderr, "--serial requires wall-clock time\n");
+    return 1;
+  }
+  if (serial_port && !SerialIO::open(serial_port)) {
+    fprintf(stderr, "Can't open serial port %s\n", serial_port);
+    return 1;
+  }
+  SerialIO::start(!Clock::isVirtualTime());
 
   #if NUM_SERIAL > 0
     MYSERIAL0.begin(BAUDRATE);
@@ -118,19 +251,27 @@ int main() {
 
   HAL_timer_init();
 
-  std::thread simulation (simulation_loop);
+  std::thread simulation_thread;
+  if (Clock::isVirtualTime()) {
+    // Update the hardware at 10kHz along with the firmware timers
+    simulation = new Simulation();
+    atexit([]{ delete simulation; }); // finish the GPIO trace when a replay ends
+    simulation_timer.init(2, 1000000, simulation_tick);
+    simulation_timer.start(10000);
+    simulation_timer.enable();
+  }
+  else
+    simulation_thread = std::thread(simulation_loop);
 
   DELAY_US(10000);
 
   setup();
   for (;;) {
+    main_loop_idle = true;
     loop();
-    std::this_thread::yield();
   }
 
-  simulation.join();
-  write_serial.join();
-  read_serial.join();
+  if (simulation_thread.joinable()) simulation_thread.join();
 }
 
 #endif // __PLAT_LINUX__
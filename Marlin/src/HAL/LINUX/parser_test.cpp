@@ -0,0 +1,145 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../inc/MarlinConfig.h"
+#include "../../gcode/parser.h"
+#include "parser_test.h"
+
+namespace ParserTest {
+
+  static uint32_t failures = 0;
+
+  static uint32_t bits(const float f) { uint32_t b; memcpy(&b, &f, sizeof(b)); return b; }
+
+  static void check_float(const std::string &num, const char * const tail) {
+    const float expect = strtof(num.c_str(), nullptr),
+                got = GCodeParser::scan_float((num + tail).c_str());
+    if (bits(got) != bits(expect) && failures++ < 10)
+      printf("  float \"%s%s\": got %.9g, strtof %.9g\n", num.c_str(), tail, double(got), double(expect));
+  }
+
+  static void check_int(const std::string &num) {
+    // The C library, with 32-bit long
+    const char *p = num.c_str();
+    const bool neg = *p == '-';
+    if (neg || *p == '+') ++p;
+    const unsigned long long mag = strtoull(p, nullptr, 10);
+    const bool over = mag > UINT32_MAX;
+    const int32_t expect_long = neg ? (mag > 0x80000000ULL ? INT32_MIN : int32_t(-int64_t(mag))) : (mag > INT32_MAX ? INT32_MAX : int32_t(mag));
+    const uint32_t expect_ulong = over ? UINT32_MAX : neg ? uint32_t(-uint32_t(mag)) : uint32_t(mag);
+
+    const int32_t got_long = GCodeParser::scan_long(num.c_str());
+    const uint32_t got_ulong = GCodeParser::scan_ulong(num.c_str());
+    if ((got_long != expect_long || got_ulong != expect_ulong) && failures++ < 10)
+      printf("  int \"%s\": got %d / %u, strtol %d / %u\n", num.c_str(), got_long, got_ulong, expect_long, expect_ulong);
+  }
+
+  static std::string random_number(std::mt19937 &rng) {
+    std::string s;
+    switch (rng() % 4) { case 0: s += '-'; break; case 1: if (rng() % 4 == 0) s += '+'; break; }
+    const uint8_t whole = rng() % 10, decimals = rng() % 2 ? rng() % 10 : 0;
+    const bool point = decimals || rng() % 8 == 0;
+    for (uint8_t i = 0; i < whole; i++) s += char('0' + rng() % 10);
+    if (point) s += '.';
+    for (uint8_t i = 0; i < decimals; i++) s += char('0' + rng() % 10);
+    if (!whole && !decimals) s += char('0' + rng() % 10); // At least one digit
+    return s;
+  }
+
+  // The old value_float, with 'E' cut off for strtof
+  static float strtof_no_exponent(char * const p) {
+    for (char *e = p;; ++e) {
+      const char c = *e;
+      if (c == '\0' || c == ' ') break;
+      if (c == 'E' || c == 'e') {
+        *e = '\0';
+        const float ret = strtof(p, nullptr);
+        *e = c;
+        return ret;
+      }
+    }
+    return strtof(p, nullptr);
+  }
+
+  template<typename F>
+  static double time_ns(const std::vector<std::string> &nums, F func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint8_t pass = 0; pass < 10; pass++)
+      for (const std::string &n : nums) func(const_cast<char*>(n.c_str()));
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (10.0 * nums.size());
+  }
+
+  int run(const uint32_t iterations) {
+    static const char * const tails[] = { "", " ", " X1.5", "E5", "e-3", "*71", ".5", "X" };
+    char num[32];
+
+    printf("Exhaustive 0 to 9999.999\n");
+    for (uint32_t i = 0; i < 10000000; i++) {
+      snprintf(num, sizeof(num), "%u.%03u", i / 1000, i % 1000);
+      check_float(num, "");
+    }
+
+    printf("%u random numbers\n", iterations);
+    std::mt19937 rng(1);
+    for (uint32_t i = 0; i < iterations; i++) {
+      const std::string n = random_number(rng);
+      const bool point = n.find('.') != std::string::npos;
+      const char * const tail = tails[rng() % COUNT(tails)];
+      check_float(n, point || *tail != '.' ? tail : "");   // A point after an integer would be part of it
+      if (!point) check_int(n);
+    }
+    static const char * const edges[] = { "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296", "-4294967295", "-4294967296", "99999999999", "-0", "+7" };
+    for (const char * const e : edges) check_int(e);
+
+    // Numbers like those in a sliced print
+    std::vector<std::string> nums;
+    for (uint32_t i = 0; i < 100000; i++) {
+      switch (i % 4) {
+        case 0: snprintf(num, sizeof(num), "%u.%03u", uint32_t(rng() % 300), uint32_t(rng() % 1000)); break;
+        case 1: snprintf(num, sizeof(num), "%u.%02u", uint32_t(rng() % 300), uint32_t(rng() % 100)); break;
+        case 2: snprintf(num, sizeof(num), "%s0.%05u", rng() % 2 ? "-" : "", uint32_t(rng() % 100000)); break;
+        case 3: snprintf(num, sizeof(num), "%u", uint32_t(600 * (1 + rng() % 20))); break;
+      }
+      nums.push_back(num);
+    }
+    volatile float fsink = 0;
+    volatile int32_t lsink = 0;
+    const double t_strtof = time_ns(nums, [&](char *p) { fsink = strtof_no_exponent(p); }),
+                 t_scan = time_ns(nums, [&](char *p) { fsink = GCodeParser::scan_float(p); }),
+                 t_strtol = time_ns(nums, [&](char *p) { lsink = strtol(p, nullptr, 10); }),
+                 t_scanl = time_ns(nums, [&](char *p) { lsink = GCodeParser::scan_long(p); });
+    printf("value_float: strtof %.1f ns, scan_float %.1f ns (%.1fx)\n", t_strtof, t_scan, t_strtof / t_scan);
+    printf("value_long:  strtol %.1f ns, scan_long %.1f ns (%.1fx)\n", t_strtol, t_scanl, t_strtol / t_scanl);
+
+    printf("%s (%u mismatches)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+  }
+
+} // ParserTest
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,38 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Checks of the G-code number scanners against the C library, run on the
+ * workstation with --test-parser.
+ *
+ *  - Every number from 0 to 9999.999, then random G-code numbers with
+ *    the characters that may follow them, must give the same float bits
+ *    as strtof and the same integers as a 32-bit strtol / strtoul.
+ *  - A benchmark times the scanners against the strtof / strtol calls
+ *    they replace.
+ */
+namespace ParserTest {
+  int run(const uint32_t iterations);
+}
@@ -0,0 +1,183 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+#include "../../gcode/queue.h"
+#include "../../module/planner.h"
+#include "../../module/stepper.h"
+#if ENABLED(SEGMENT_COALESCING)
+  #include "../../feature/segment_coalescer.h"
+#endif
+#include "replay.h"
+#include "hardware/Resonator.h"
+
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+
+int Replay::fd = -1;
+const char *Replay::gcode_file = nullptr,
+           *Replay::report_file = nullptr;
+bool Replay::started = false,
+     Replay::eof = false,
+     Replay::line_start = true,
+     Replay::was_queued = false;
+uint32_t Replay::lines = 0,
+         Replay::blocks = 0,
+         Replay::planner_starved = 0;
+uint16_t Replay::last_head = 0,
+         Replay::queue_peak = 0;
+uint64_t Replay::start_nanos = 0,
+         Replay::start_wall = 0;
+
+static uint64_t wall_nanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool Replay::open(const char *gcode, const char *report) {
+  fd = ::open(gcode, O_RDONLY);
+  if (fd < 0) return false;
+  gcode_file = gcode;
+  report_file = report;
+  return true;
+}
+
+// Called from HAL_idletask once setup() is done
+void Replay::idle() {
+  if (!started) {
+    started = true;
+    last_head = planner.block_buffer_head;
+    start_nanos = Clock::nanos();
+    start_wall = wall_nanos();
+  }
+  feed();
+  sample();
+  if (!pending() && !planner.has_blocks_queued() && !TERN0(INPUT_SHAPING, stepper.shaping_busy())) report();
+}
+
+// Fill the serial receive buffer, counting the lines that aren't blank or comments
+void Replay::feed() {
+  uint8_t buffer[128];
+  while (!eof && usb_serial.receive_buffer.free()) {
+    const ssize_t len = read(fd, buffer, _MIN(usb_serial.receive_buffer.free(), sizeof(buffer)));
+    if (len <= 0) { eof = true; break; }
+    for (ssize_t i = 0; i < len; i++) {
+      const char c = buffer[i];
+      if (c == '\n' || c == '\r')
+        line_start = true;
+      else if (line_start && c != ' ' && c != '\t') {
+        line_start = false;
+        if (c != ';') lines++;
+      }
+      usb_serial.receive_buffer.write(c);
+    }
+  }
+}
+
+// Input not yet executed, in the file, the serial buffer or the command queue
+bool Replay::pending() {
+  return !eof || usb_serial.receive_buffer.available() || queue.length;
+}
+
+// Runs once per HAL_idletask. Blocks are counted from the head index, which
+// can't lap the tail between two calls, so none are missed.
+void Replay::sample() {
+  const uint16_t head = planner.block_buffer_head;
+  blocks += BLOCK_MOD(head - last_head);
+  last_head = head;
+
+  NOLESS(queue_peak, queue.length);
+
+  // The planner ran dry with nothing queued to refill it, though input was
+  // left. A command waiting in the queue (e.g., M109 heating) doesn't count.
+  const bool queued = planner.has_blocks_queued();
+  if (was_queued && !queued && !queue.length && pending()) planner_starved++;
+  was_queued = queued;
+}
+
+void Replay::report() {
+  const double print_time = (Clock::nanos() - start_nanos) / 1000000000.0,
+               wall_time = (wall_nanos() - start_wall) / 1000000000.0;
+
+  FILE *out = report_file ? fopen(report_file, "w") : stderr;
+  if (out == nullptr) out = stderr;
+  fprintf(out, "{\n"
+               "  \"file\": \"%s\",\n"
+               "  \"lines\": %u,\n"
+               "  \"planner_blocks\": %u,\n"
+               "  \"planner_starved\": %u,\n"
+               "  \"queue_peak\": %u,\n"
+               "  \"print_time_s\": %.6f,\n"
+               "  \"wall_time_s\": %.6f,\n"
+               "  \"lines_per_s\": %.1f,\n"
+               "  \"blocks_per_s\": %.1f,\n"
+               "  \"steps\": { \"x\": %d, \"y\": %d, \"z\": %d, \"e\": %d }",
+    gcode_file, lines, blocks, planner_starved, queue_peak, print_time, wall_time,
+    wall_time > 0 ? lines / wall_time : 0.0, wall_time > 0 ? blocks / wall_time : 0.0,
+    stepper.position(X_AXIS), stepper.position(Y_AXIS), stepper.position(Z_AXIS), stepper.position(E_AXIS)
+  );
+  #if ENABLED(SEGMENT_COALESCING)
+    fprintf(out, ",\n  \"coalescing\": { \"segments\": %u, \"merged\": %u, \"blocks\": %u }",
+      coalescer.segments, coalescer.merged, coalescer.blocks);
+  #endif
+  if (Resonator::enabled()) {
+    // Swing left at each stop, converted to mm
+    fprintf(out, ",\n  \"resonance\": { \"hz\": %.2f, \"zeta\": %.3f", Resonator::frequency, Resonator::zeta);
+    Resonator * const axis[] = { &x_resonator, &y_resonator };
+    LOOP_L_N(a, 2) {
+      Resonator &r = *axis[a];
+      r.finish();
+      const double mm = planner.settings.axis_steps_per_mm[a];
+      fprintf(out, ", \"%c\": { \"stops\": %u, \"max_residual_mm\": %.5f, \"mean_residual_mm\": %.5f }",
+        'x' + a, r.stops, r.max_residual / mm, r.stops ? r.total_residual / r.stops / mm : 0.0);
+    }
+    fprintf(out, " }");
+  }
+  #if ENABLED(PLANNER_FIXED_POINT_CHECK)
+    // Fixed-point trapezoids against the float reference
+    const trapezoid_t &err = planner.fixed_point_error;
+    const uint32_t n = planner.fixed_point_checks;
+    fprintf(out, ",\n"
+                 "  \"fixed_point_check\": {\n"
+                 "    \"trapezoids\": %u,\n"
+                 "    \"fixed_cycles\": %.1f,\n"
+                 "    \"float_cycles\": %.1f,\n"
+                 "    \"max_error\": { \"initial_rate\": %u, \"final_rate\": %u, \"accelerate_steps\": %u, \"plateau_steps\": %u",
+      n, n ? double(planner.fixed_point_cycles) / n : 0.0, n ? double(planner.float_cycles) / n : 0.0,
+      err.initial_rate, err.final_rate, err.accelerate_steps, err.plateau_steps
+    );
+    #if ENABLED(S_CURVE_ACCELERATION)
+      fprintf(out, ", \"cruise_rate\": %u, \"acceleration_time\": %u, \"deceleration_time\": %u",
+        err.cruise_rate, err.acceleration_time, err.deceleration_time);
+    #endif
+    fprintf(out, " }\n  }");
+  #endif
+  fprintf(out, "\n}\n");
+  if (out != stderr) fclose(out);
+
+  MYSERIAL0.flushTX();
+  fflush(stdout);
+  exit(EXIT_SUCCESS);
+}
+
+#endif // __PLAT_LINUX__
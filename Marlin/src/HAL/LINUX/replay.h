@@ -0,0 +1,52 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Headless G-code replay for benchmarking the firmware on a workstation.
+ *
+ * The file is streamed into the serial receive buffer in virtual time, so it
+ * goes through GCodeQueue and the planner exactly like host input. When every
+ * command has run and the planner is empty a JSON report is written and the
+ * simulator exits.
+ */
+class Replay {
+public:
+  static bool open(const char *gcode_file, const char *report_file);
+  static bool active() { return fd >= 0; }
+  static void idle();
+
+private:
+  static void feed();
+  static void sample();
+  static bool pending();
+  static void report();
+
+  static int fd;
+  static const char *gcode_file, *report_file;
+  static bool started, eof, line_start, was_queued;
+  static uint32_t lines, blocks, planner_starved;
+  static uint16_t last_head, queue_peak;
+  static uint64_t start_nanos, start_wall;
+};
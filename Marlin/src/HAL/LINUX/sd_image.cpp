@@ -0,0 +1,124 @@
+/**
+ * Marlin 3D Printer Firmware
+ *
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <random>
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SDSUPPORT)
+
+#include "../../sd/SdVolume.h"
+#include "hardware/Clock.h"
+
+const char *Sd2Card::image = nullptr;
+Sd2Card::timing_t Sd2Card::timing = { 0, 0, 0 };
+Sd2Card::errors_t Sd2Card::errors = { 0, 1 };
+Sd2Card::stats_t Sd2Card::stats;
+
+static std::mt19937 error_rng;
+
+// The image card has no SPI bus to set up
+void spiBegin() {}
+void spiInit(uint8_t) {}
+
+// Take as long as the card would
+static void card_wait(const uint32_t us) {
+  if (!us) return;
+  Sd2Card::stats.busy_ns += us * 1000ULL;
+  Clock::delayMicros(us);
+}
+
+bool Sd2Card::init(const uint8_t, const pin_t) {
+  if (fd_ >= 0) close(fd_);
+  TERN_(SD_MULTIBLOCK_READ, streaming_ = false);
+  error_rng.seed(errors.seed);
+  fd_ = image ? open(image, O_RDWR) : -1;
+  if (fd_ < 0 && image) fd_ = open(image, O_RDONLY);  // Like a locked card, writes fail
+  return fd_ >= 0;
+}
+
+uint32_t Sd2Card::cardSize() {
+  return fd_ < 0 ? 0 : uint32_t(lseek(fd_, 0, SEEK_END) >> 9);
+}
+
+// A command and its response. Any command ends a multi-block read first.
+void Sd2Card::command() {
+  #if ENABLED(SD_MULTIBLOCK_READ)
+    if (streaming_) { streaming_ = false; command(); }  // CMD12
+  #endif
+  stats.commands++;
+  card_wait(timing.command_us);
+}
+
+// Move one block to or from the image, or fail it by the error model
+bool Sd2Card::transfer(const uint32_t block, uint8_t *dst, const uint8_t *src) {
+  card_wait(timing.block_us);
+  if (errors.one_in && error_rng() % errors.one_in == 0) {
+    stats.errors++;
+    return false;
+  }
+  const off_t pos = off_t(block) << 9;
+  if (dst) {
+    if (pread(fd_, dst, 512, pos) != 512) return false;
+    stats.blocks_read++;
+  }
+  else {
+    if (pwrite(fd_, src, 512, pos) != 512) return false;
+    stats.blocks_written++;
+    card_wait(timing.busy_us);
+  }
+  return true;
+}
+
+bool Sd2Card::readBlock(uint32_t block, uint8_t *dst) {
+  if (fd_ < 0) return false;
+  for (uint8_t retryCnt = TERN(SD_CHECK_AND_RETRY, 3, 1); retryCnt--;) {
+    command();                                  // CMD17
+    if (transfer(block, dst, nullptr)) return true;
+  }
+  return false;
+}
+
+bool Sd2Card::writeBlock(uint32_t block, const uint8_t *src) {
+  if (fd_ < 0) return false;
+  command();                                    // CMD24
+  return transfer(block, nullptr, src);
+}
+
+#if ENABLED(SD_MULTIBLOCK_READ)
+
+  // Blocks that follow on come from one open CMD18, as on the SPI card
+  bool Sd2Card::readSequential(const uint32_t block, uint8_t *dst) {
+    if (fd_ < 0) return false;
+    if (!streaming_ || block != streamBlock_) {
+      command();                                // CMD18, after CMD12 if streaming
+      streaming_ = true;
+    }
+    streamBlock_ = block + 1;
+    return transfer(block, dst, nullptr) || readBlock(block, dst);
+  }
+
+#endif
+
+#endif // SDSUPPORT
+#endif // __PLAT_LINUX__
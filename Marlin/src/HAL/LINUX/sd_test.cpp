@@ -0,0 +1,194 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SDSUPPORT)
+
+#include "../../sd/SdFile.h"
+#include "sd_test.h"
+
+namespace SDTest {
+
+  typedef struct {
+    uint32_t bytes, sum, failures;
+    Sd2Card::stats_t card;
+    double host_ms;
+  } pass_t;
+
+  static void report(const char * const name, const pass_t &p) {
+    const double card_s = p.card.busy_ns * 1e-9;
+    printf("%-12s %6u commands %6u blocks %4u errors  card %8.3f s", name, p.card.commands, p.card.blocks_read + p.card.blocks_written, p.card.errors, card_s);
+    if (card_s > 0 && p.bytes > 512) printf(" %7.3f MB/s", p.bytes / card_s * 1e-6);
+    printf("  host %7.2f ms\n", p.host_ms);
+  }
+
+  // The card's work since 'before'
+  static void finish(pass_t &p, const Sd2Card::stats_t &before, const std::chrono::steady_clock::time_point &start) {
+    p.host_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    p.card = Sd2Card::stats;
+    p.card.commands -= before.commands;
+    p.card.blocks_read -= before.blocks_read;
+    p.card.blocks_written -= before.blocks_written;
+    p.card.errors -= before.errors;
+    p.card.busy_ns -= before.busy_ns;
+  }
+
+  // Read the whole file with reads of 'chunk' bytes, like the firmware
+  static pass_t read_pass(SdFile &file, const uint16_t chunk, std::vector<uint8_t> *data=nullptr) {
+    pass_t p = { 0, 0, 0 };
+    uint8_t buf[512];
+    const Sd2Card::stats_t before = Sd2Card::stats;
+    const auto start = std::chrono::steady_clock::now();
+
+    file.seekSet(0);
+    while (p.bytes < file.fileSize()) {
+      const int16_t n = chunk == 1 ? file.read() : file.read(buf, chunk);
+      if (n < 0) {                              // Skip what can't be read, as a print would
+        p.failures++;
+        if (!file.seekSet(_MIN(file.fileSize(), p.bytes + chunk))) break;
+        p.bytes = file.curPosition();
+        if (data) data->resize(p.bytes);
+        continue;
+      }
+      if (chunk == 1) { p.bytes++; p.sum = p.sum * 31 + n; }
+      else {
+        if (!n) break;
+        for (int16_t i = 0; i < n; i++) p.sum = p.sum * 31 + buf[i];
+        if (data) data->insert(data->end(), buf, buf + n);
+        p.bytes += n;
+      }
+    }
+
+    finish(p, before, start);
+    return p;
+  }
+
+  // Seek back and forth in the file and read a byte, like M26 and power-loss resume
+  static pass_t seek_pass(SdFile &file, const std::vector<uint8_t> &data) {
+    pass_t p = { 0, 0, 0 };
+    const Sd2Card::stats_t before = Sd2Card::stats;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::mt19937 rng(1);
+    for (uint16_t i = 0; i < 200 && data.size(); i++) {
+      const uint32_t pos = rng() % data.size();
+      const int16_t c = file.seekSet(pos) ? file.read() : -1;
+      if (c != data[pos]) p.failures++;
+      p.bytes++;
+    }
+
+    finish(p, before, start);
+    return p;
+  }
+
+  // Write a file in 96-byte pieces, as M28 does, with an idle() after each.
+  // Note the longest wait on the card in any one write().
+  static pass_t write_pass(SdBaseFile &dir, const char * const name, const uint32_t size, uint64_t &longest) {
+    pass_t p = { 0, 0, 0 };
+    SdFile out;
+    const Sd2Card::stats_t before = Sd2Card::stats;
+    const auto start = std::chrono::steady_clock::now();
+
+    longest = 0;
+    if (out.open(&dir, name, O_CREAT | O_WRITE | O_TRUNC)) {
+      std::mt19937 rng(2);
+      uint8_t buf[96];
+      while (p.bytes < size) {
+        const int16_t n = _MIN(sizeof(buf), size - p.bytes);
+        for (int16_t i = 0; i < n; i++) p.sum = p.sum * 31 + (buf[i] = rng());
+        const uint64_t was = Sd2Card::stats.busy_ns;
+        if (out.write(buf, n) != n) p.failures++;
+        NOLESS(longest, Sd2Card::stats.busy_ns - was);
+        TERN_(SD_WRITE_BEHIND, SdWriteQueue::idle());
+        p.bytes += n;
+      }
+      if (!out.close()) p.failures++;
+    }
+    else
+      p.failures++;
+
+    finish(p, before, start);
+    return p;
+  }
+
+  int run(const char * const path) {
+    static Sd2Card card;
+    static SdVolume volume;
+    static SdFile root, file;
+    #ifdef SD_FILE_EXTENTS
+      static SdExtents extents;
+      file.useExtents(&extents);
+    #endif
+
+    if (!card.init()) { printf("No SD image (--sd-image <file>)\n"); return 1; }
+    if (!volume.init(&card)) { printf("No FAT volume in %s\n", Sd2Card::image); return 1; }
+    if (!root.openRoot(&volume)) { printf("Can't open the root directory\n"); return 1; }
+
+    pass_t open = { 0, 0, 0 };
+    const Sd2Card::stats_t before = Sd2Card::stats;
+    const auto start = std::chrono::steady_clock::now();
+    if (!file.open(&root, path, O_READ)) { printf("Can't open %s\n", path); return 1; }
+    finish(open, before, start);
+
+    printf("%s: %u bytes, FAT%u, %u blocks per cluster", path, file.fileSize(), volume.fatType(), volume.blocksPerCluster());
+    #ifdef SD_FILE_EXTENTS
+      printf(", %u of %u runs map %u clusters", extents.runs, SD_FILE_EXTENTS, extents.clusters);
+    #endif
+    printf("\n");
+
+    std::vector<uint8_t> data;
+    const pass_t bytes = read_pass(file, 1), blocks = read_pass(file, 512, &data), seeks = seek_pass(file, data);
+    report("open", open);
+    report("byte reads", bytes);
+    report("block reads", blocks);
+    report("200 seeks", seeks);
+
+    // Write a file and read it back, then remove it
+    static const char write_name[] = "SDTEST.BIN";
+    uint64_t longest;
+    SdFile back;
+    const pass_t writes = write_pass(root, write_name, 65536, longest);
+    const pass_t check = back.open(&root, write_name, O_RDWR) ? read_pass(back, 512) : pass_t{ 0, 0, 1 };
+    if (back.isOpen()) back.remove();
+    report("64K writes", writes);
+    printf("%-12s longest card wait in one write() %.3f ms\n", "", longest * 1e-6);
+
+    const bool same = bytes.bytes == blocks.bytes && bytes.sum == blocks.sum;
+    if (!same) printf("The passes read different data\n");
+    const bool written = writes.bytes == check.bytes && writes.sum == check.sum;
+    if (!written) printf("The file read back isn't what was written\n");
+    const uint32_t failures = bytes.failures + blocks.failures + seeks.failures + writes.failures + check.failures;
+    const bool passed = same && written && !failures;
+    printf("%s (%u failed reads and writes)\n", passed ? "PASSED" : "FAILED", failures);
+    return passed ? 0 : 1;
+  }
+
+} // SDTest
+
+#endif // SDSUPPORT
+#endif // __PLAT_LINUX__
@@ -0,0 +1,42 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * A read benchmark of the SD card, run on the workstation with
+ * --sd-image <file> --test-sd <path>.
+ *
+ * The file is read twice in virtual time from the disk image card, first
+ * a byte at a time as CardReader::get does, then in 512-byte reads as with
+ * SD_READ_AHEAD, which stream with SD_MULTIBLOCK_READ. Then it seeks to
+ * bytes all over the file, as M26 does. Last it writes a 64K file in
+ * 96-byte pieces, as M28 does, reads it back and removes it. Each pass
+ * reports the card commands, blocks and modeled card time (see
+ * --sd-timing), and all must give the same data. The write pass also
+ * reports the longest time one write() waited for the card, which
+ * SD_WRITE_BEHIND keeps down.
+ */
+namespace SDTest {
+  int run(const char * const path);
+}
@@ -0,0 +1,312 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+#include "serial_io.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+static int in_fd = STDIN_FILENO,  // Host -> firmware
+           out_fd = STDOUT_FILENO,// Firmware -> host
+           listen_fd = -1,        // TCP server socket
+           pty_slave = -1,        // Held open so the PTY survives host reconnects
+           kick_fd = -1,          // eventfd: firmware -> I/O thread
+           epoll_fd = -1;
+static const char *pty_link = nullptr;
+
+static bool receiving = false,    // The I/O thread owns the receive buffer
+            in_polled = false,    // in_fd is in epoll (regular files can't be)
+            out_blocked = false;  // Waiting for EPOLLOUT
+static uint32_t in_events = 0, out_events = 0, listen_events = 0;
+
+static std::atomic<bool> running{false}, rx_stalled{false};
+static std::atomic<uint32_t> tx_unsent{0};
+
+static std::mutex wait_mutex;
+static std::condition_variable wait_cv;
+
+static uint8_t tx_data[512];
+static uint32_t tx_len = 0, tx_pos = 0;
+
+static void kick() {
+  const uint64_t one = 1;
+  if (kick_fd >= 0) UNUSED(write(kick_fd, &one, sizeof(one)));  // Async-signal-safe
+}
+
+static void wake_firmware() {
+  { std::lock_guard<std::mutex> lock(wait_mutex); }
+  wait_cv.notify_all();
+}
+
+// Add, change or remove an fd in the epoll set
+static void watch(const int fd, uint32_t &current, const uint32_t wanted) {
+  if (fd < 0 || current == wanted) return;
+  epoll_event ev = {};
+  ev.events = wanted;
+  ev.data.fd = fd;
+  epoll_ctl(epoll_fd, !current ? EPOLL_CTL_ADD : wanted ? EPOLL_CTL_MOD : EPOLL_CTL_DEL, fd, &ev);
+  current = wanted;
+}
+
+static void set_nonblocking(const int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK); }
+
+static bool open_pty(const char *link) {
+  const int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) || unlockpt(master)) return false;
+  const char * const name = ptsname(master);
+  pty_slave = ::open(name, O_RDWR | O_NOCTTY);
+  if (pty_slave < 0) return false;
+
+  termios tio;
+  tcgetattr(pty_slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(pty_slave, TCSANOW, &tio);
+
+  set_nonblocking(master);
+  in_fd = out_fd = master;
+
+  if (link) {
+    unlink(link);
+    if (symlink(name, link)) return false;
+    pty_link = link;
+    atexit([]{ unlink(pty_link); });
+  }
+  fprintf(stderr, "Serial port: %s\n", link ? link : name);
+  return true;
+}
+
+static bool open_tcp(const int port) {
+  listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (listen_fd < 0) return false;
+  const int yes = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (bind(listen_fd, (sockaddr*)&addr, sizeof(addr)) || listen(listen_fd, 1)) return false;
+  in_fd = out_fd = -1;
+  usb_serial.host_connected = false;  // Output is dropped until a client connects
+  fprintf(stderr, "Serial port: tcp://127.0.0.1:%d\n", port);
+  return true;
+}
+
+bool SerialIO::open(const char *spec) {
+  if (!strcmp(spec, "stdio")) return true;
+  if (!strcmp(spec, "pty")) return open_pty(nullptr);
+  if (!strncmp(spec, "pty:", 4)) return open_pty(spec + 4);
+  if (!strncmp(spec, "tcp:", 4)) {
+    const int port = atoi(spec + 4);
+    return port > 0 && port < 65536 && open_tcp(port);
+  }
+  return false;
+}
+
+static void accept_client() {
+  const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK);
+  if (fd < 0) return;
+  in_fd = out_fd = fd;
+  in_polled = true;
+  out_blocked = false;
+  usb_serial.host_connected = true;
+  wake_firmware();
+}
+
+// The host went away: stop reading, and for TCP wait for the next client
+static void disconnect() {
+  watch(in_fd, in_events, 0);
+  if (listen_fd >= 0) {
+    close(in_fd);
+    out_fd = -1;
+    usb_serial.host_connected = false;
+    out_events = 0;
+  }
+  in_fd = -1;
+  wake_firmware();
+}
+
+static void receive() {
+  const uint32_t space = usb_serial.receive_buffer.free();
+  if (!space) return;
+  uint8_t data[512];
+  const ssize_t len = read(in_fd, data, _MIN(space, sizeof(data)));
+  if (len > 0) {
+    for (ssize_t i = 0; i < len; i++) usb_serial.receive_buffer.write(data[i]);
+    wake_firmware();
+  }
+  else if (len == 0 || (errno != EAGAIN && errno != EINTR))
+    disconnect();
+}
+
+static void send() {
+  const bool had_data = tx_unsent || usb_serial.transmit_buffer.available();
+  for (;;) {
+    if (tx_pos == tx_len) {
+      tx_pos = tx_len = 0;
+      while (tx_len < sizeof(tx_data) && usb_serial.transmit_buffer.available())
+        tx_data[tx_len++] = usb_serial.transmit_buffer.read();
+      tx_unsent = tx_len;
+      if (!tx_len) break;
+    }
+    if (out_fd < 0) { tx_pos = tx_len; continue; }  // No host: drop the output
+    if (out_blocked) break;
+    const ssize_t len = write(out_fd, tx_data + tx_pos, tx_len - tx_pos);
+    if (len > 0) {
+      tx_pos += len;
+      tx_unsent = tx_len - tx_pos;
+    }
+    else if (errno == EAGAIN)
+      out_blocked = true;
+    else if (errno != EINTR) {
+      if (in_fd == out_fd) disconnect(); else out_fd = -1;
+    }
+  }
+  if (had_data) wake_firmware();
+}
+
+// Decide which events to wait for
+static void update_watches() {
+  uint32_t in_wanted = 0;
+  if (receiving && in_fd >= 0 && in_polled) {
+    rx_stalled = true;
+    if (usb_serial.receive_buffer.free()) {  // Checked after raising the flag, so no kick is lost
+      rx_stalled = false;
+      in_wanted = EPOLLIN;
+    }
+  }
+  const uint32_t out_wanted = (out_fd >= 0 && out_blocked) ? EPOLLOUT : 0;
+  if (in_fd == out_fd)
+    watch(in_fd, in_events, in_wanted | out_wanted);
+  else {
+    watch(in_fd, in_events, in_wanted);
+    watch(out_fd, out_events, out_wanted);
+  }
+  watch(listen_fd, listen_events, (listen_fd >= 0 && in_fd < 0) ? EPOLLIN : 0);
+}
+
+static void io_thread() {
+  // Leave the timer signals (the simulated ISRs) to the firmware thread
+  sigset_t all;
+  sigfillset(&all);
+  pthread_sigmask(SIG_BLOCK, &all, nullptr);
+
+  epoll_event events[4];
+  for (;;) {
+    // Regular files are always readable and can't be polled
+    if (receiving && in_fd >= 0 && !in_polled) {
+      rx_stalled = true;
+      if (usb_serial.receive_buffer.free()) { rx_stalled = false; receive(); continue; }
+    }
+
+    send();
+    update_watches();
+
+    const int count = epoll_wait(epoll_fd, events, COUNT(events), -1);
+    for (int i = 0; i < count; i++) {
+      const int fd = events[i].data.fd;
+      const uint32_t ev = events[i].events;
+      if (fd == kick_fd) {
+        uint64_t value;
+        UNUSED(read(kick_fd, &value, sizeof(value)));
+      }
+      else if (fd == listen_fd)
+        accept_client();
+      else {
+        if (fd == out_fd && (ev & EPOLLOUT)) out_blocked = false;
+        if (fd == in_fd && (ev & (EPOLLIN | EPOLLHUP | EPOLLERR))) receive();
+      }
+    }
+  }
+}
+
+void SerialIO::start(const bool receive) {
+  receiving = receive;
+  epoll_fd = epoll_create1(0);
+  kick_fd = eventfd(0, EFD_NONBLOCK);
+  uint32_t kick_events = 0;
+  watch(kick_fd, kick_events, EPOLLIN);
+
+  // epoll refuses regular files, e.g. stdin redirected from a G-code file
+  if (in_fd >= 0) {
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = in_fd;
+    in_polled = !epoll_ctl(epoll_fd, EPOLL_CTL_ADD, in_fd, &ev);
+    if (in_polled) epoll_ctl(epoll_fd, EPOLL_CTL_DEL, in_fd, &ev);
+  }
+
+  running = true;
+  std::thread(io_thread).detach();
+}
+
+void SerialIO::txWritten() {
+  // Only a write into an empty buffer needs a kick. Otherwise the I/O thread
+  // is still draining and will see the new byte before it goes back to sleep.
+  if (usb_serial.transmit_buffer.available() == 1) kick();
+}
+
+void SerialIO::rxConsumed() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (rx_stalled.exchange(false)) kick();
+}
+
+void SerialIO::waitTxSpace() {
+  if (!running) return;
+  std::unique_lock<std::mutex> lock(wait_mutex);
+  wait_cv.wait_for(lock, std::chrono::milliseconds(1), []{
+    return usb_serial.transmit_buffer.free() || !usb_serial.host_connected;
+  });
+}
+
+void SerialIO::waitTxEmpty() {
+  if (!running) return;
+  std::unique_lock<std::mutex> lock(wait_mutex);
+  while (!wait_cv.wait_for(lock, std::chrono::milliseconds(1), []{
+    return (!usb_serial.transmit_buffer.available() && !tx_unsent) || !usb_serial.host_connected;
+  })) { /* nada */ }
+}
+
+void SerialIO::waitRx(const uint32_t us) {
+  std::unique_lock<std::mutex> lock(wait_mutex);
+  wait_cv.wait_for(lock, std::chrono::microseconds(us), []{
+    return usb_serial.receive_buffer.available() > 0;
+  });
+}
+
+#endif // __PLAT_LINUX__
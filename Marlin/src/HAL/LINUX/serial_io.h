@@ -0,0 +1,52 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Event-driven host connection for the simulated serial port.
+ *
+ * One I/O thread blocks in epoll on the host side (stdio, a PTY or a TCP
+ * socket) and moves data between it and the HalSerial ring buffers. The
+ * firmware side never spins: it kicks the thread through an eventfd when it
+ * writes into an empty transmit buffer or frees a stalled receive buffer,
+ * and sleeps on a condition variable while it waits for buffer space, for
+ * the transmit buffer to drain, or for new input.
+ *
+ * Spec strings for open():
+ *   stdio          stdin / stdout (default)
+ *   pty[:<link>]   New pseudo-terminal, optionally symlinked to <link>
+ *   tcp:<port>     Listen on 127.0.0.1:<port>, one client at a time
+ */
+class SerialIO {
+public:
+  static bool open(const char *spec);
+  static void start(const bool receive);  // Without receive the firmware reads stdin itself (virtual time)
+
+  // Firmware side
+  static void txWritten();                // A byte was added to the transmit buffer
+  static void rxConsumed();               // A byte was taken from the receive buffer
+  static void waitTxSpace();              // Sleep until the transmit buffer has room
+  static void waitTxEmpty();              // Sleep until everything written has been sent
+  static void waitRx(const uint32_t us);  // Sleep until input arrives or the timeout expires
+};
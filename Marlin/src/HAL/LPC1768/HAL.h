@@ -198,6 +198,15 @@ int16_t PARSED_PIN_INDEX(const char code, const int16_t dval);
 #define HAL_IDLETASK 1
 void HAL_idletask();
 
+// CPU cycle counter of the DWT unit, for profiling
+#define HAL_CYCLE_COUNTER 1
+FORCE_INLINE static void HAL_cycle_counter_init() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+FORCE_INLINE static uint32_t HAL_cycle_count() { return DWT->CYCCNT; }
+
 #define PLATFORM_M997_SUPPORT
 void flashFirmware(const int16_t);
 
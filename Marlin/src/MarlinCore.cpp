@@ -217,6 +217,10 @@
   #include "feature/password/password.h"
 #endif
 
+#if ENABLED(SEGMENT_COALESCING)
+  #include "feature/segment_coalescer.h"
+#endif
+
 PGMSTR(NUL_STR, "");
 PGMSTR(M112_KILL_STR, "M112 Shutdown");
 PGMSTR(G28_STR, "G28");
@@ -483,7 +487,7 @@ void startOrResumeJob() {
  */
 inline void manage_inactivity(const bool ignore_stepper_queue=false) {
 
-  if (queue.length < BUFSIZE) queue.get_available_commands();
+  if (queue.has_space()) queue.get_available_commands();
 
   const millis_t ms = millis();
 
@@ -706,6 +710,9 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   // Return if setup() isn't completed
   if (marlin_state == MF_INITIALIZING) return;
 
+  // Deliver a held G1 segment before the planner runs dry
+  TERN_(SEGMENT_COALESCING, coalescer.idle());
+
   // Handle filament runout sensors
   TERN_(HAS_FILAMENT_SENSOR, runout.run());
 
@@ -730,6 +737,9 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   // Handle SD Card insert / remove
   TERN_(SDSUPPORT, card.manage_media());
 
+  // Write one block waiting for the SD card
+  TERN_(SD_WRITE_BEHIND, SdWriteQueue::idle());
+
   // Handle USB Flash Drive insert / remove
   TERN_(USB_FLASH_DRIVE_SUPPORT, Sd2Card::idle());
 
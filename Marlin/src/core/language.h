@@ -119,6 +119,7 @@
 #define STR_ERR_LINE_NO                     "Line Number is not Last Line Number+1, Last Line: "
 #define STR_ERR_CHECKSUM_MISMATCH           "checksum mismatch, Last Line: "
 #define STR_ERR_NO_CHECKSUM                 "No Checksum with line number, Last Line: "
+#define STR_ERR_BAD_FRAME                   "Bad binary frame, Last Line: "
 #define STR_FILE_PRINTED                    "Done printing file"
 #define STR_BEGIN_FILE_LIST                 "Begin file list"
 #define STR_END_FILE_LIST                   "End file list"
@@ -0,0 +1,176 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * binary_motion.cpp - Compact binary frames for streamed moves
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+
+#include "binary_motion.h"
+#include "../libs/crc16.h"
+
+BinaryMotion binary_motion;
+
+BinaryMotion::port_t BinaryMotion::port[NUM_SERIAL];
+
+enum RecordType : uint8_t { REC_G1, REC_G0, REC_TEXT, REC_END };
+
+static constexpr char word_letter[XYZE + 1] = { 'X', 'Y', 'Z', 'E', 'F' };
+static constexpr uint8_t word_decimals[XYZE + 1] = { 3, 3, 3, 5, 0 };
+
+void BinaryMotion::set_active(const uint8_t p, const bool onoff) {
+  port_t &pt = port[p];
+  pt.active = onoff;
+  pt.state = HUNT;
+  pt.pos = 0;
+  ZERO(pt.word);
+}
+
+BinaryMotion::Result BinaryMotion::receive(const uint8_t p, const uint8_t c) {
+  port_t &pt = port[p];
+
+  if (c == SYNC) {                          // Always the start of a frame
+    pt.state = DATA;
+    pt.count = 0;
+    return NEED_MORE;
+  }
+  if (pt.state == HUNT) return NEED_MORE;   // Skip anything between frames
+  if (c == '\n' || c == '\r') {             // Never in a frame. Drop the broken one.
+    pt.state = HUNT;
+    return NEED_MORE;
+  }
+  if (c == ESC) { pt.state = ESCAPED; return NEED_MORE; }
+
+  pt.frame[pt.count++] = pt.state == ESCAPED ? c ^ 0x20 : c;
+  pt.state = DATA;
+
+  if (pt.count == 2 && pt.frame[1] > BINARY_MOTION_FRAME_SIZE) {
+    pt.state = HUNT;
+    return BAD_FRAME;
+  }
+  if (pt.count < 2 || pt.count < pt.frame[1] + 4) return NEED_MORE;
+
+  // The whole frame is here
+  pt.state = HUNT;
+  const uint8_t end = pt.frame[1] + 2;
+  uint16_t crc = 0xFFFF;
+  crc16(&crc, pt.frame, end);
+  if (crc != (pt.frame[end] | (pt.frame[end + 1] << 8))) return BAD_CHECKSUM;
+  return validate(pt) ? FRAME_OK : BAD_FRAME;
+}
+
+// Read a LEB128 varint of up to 5 bytes. Return the bytes used, or 0 if it runs past 'end'.
+static uint8_t read_varint(const uint8_t *b, const uint8_t *end, uint32_t &v) {
+  v = 0;
+  LOOP_L_N(i, 5) {
+    if (b + i >= end) return 0;
+    v |= uint32_t(b[i] & 0x7F) << (7 * i);
+    if (!(b[i] & 0x80)) return i + 1;
+  }
+  return 0;
+}
+
+// Check every record before queueing any of them
+bool BinaryMotion::validate(const port_t &pt) {
+  const uint8_t *b = &pt.frame[2], * const end = b + pt.frame[1];
+  if (b == end) return false;
+  while (b < end) {
+    const uint8_t h = *b++;
+    switch (h & 0x3) {
+      case REC_G1: case REC_G0:
+        if (h & 0x80) return false;
+        LOOP_L_N(i, XYZE + 1) if (TEST(h, i + 2)) {
+          uint32_t v;
+          const uint8_t n = read_varint(b, end, v);
+          if (!n) return false;
+          b += n;
+        }
+        break;
+      case REC_TEXT:
+        if (h & 0xFC || b >= end || !*b || *b >= MAX_CMD_SIZE || b + 1 + *b > end) return false;
+        b += 1 + *b;
+        break;
+      case REC_END:
+        if (h & 0xFC || b != end) return false;
+        break;
+    }
+  }
+  return true;
+}
+
+// Append " <letter><value>", with the value scaled down by 10^decimals and no trailing zeros
+static char* append_word(char *s, const char letter, const int32_t value, const uint8_t decimals) {
+  *s++ = ' ';
+  *s++ = letter;
+  uint32_t u = value;
+  if (value < 0) { *s++ = '-'; u = -u; }
+  char digits[10];
+  uint8_t n = 0;
+  do { digits[n++] = '0' + u % 10; u /= 10; } while (u || n <= decimals);
+  uint8_t zeros = 0;
+  while (zeros < decimals && digits[zeros] == '0') zeros++;
+  while (n > decimals) *s++ = digits[--n];
+  if (zeros < decimals) {
+    *s++ = '.';
+    while (n > zeros) *s++ = digits[--n];
+  }
+  return s;
+}
+
+bool BinaryMotion::next_command(const uint8_t p, char * const cmd) {
+  port_t &pt = port[p];
+  const uint8_t *b = &pt.frame[pt.pos], * const end = &pt.frame[2 + pt.frame[1]];
+  const uint8_t h = *b++;
+  char *s = cmd;
+  switch (h & 0x3) {
+    case REC_G1: case REC_G0:
+      *s++ = 'G';
+      *s++ = (h & 0x3) == REC_G0 ? '0' : '1';
+      LOOP_L_N(i, XYZE + 1) if (TEST(h, i + 2)) {
+        uint32_t v;
+        b += read_varint(b, end, v);
+        // X Y Z E are zigzag deltas, F is absolute
+        pt.word[i] = i < XYZE ? pt.word[i] + int32_t((v >> 1) ^ -(v & 1)) : int32_t(v);
+        s = append_word(s, word_letter[i], pt.word[i], word_decimals[i]);
+      }
+      break;
+    case REC_TEXT: {
+      const uint8_t n = *b++;
+      memcpy(s, b, n);
+      s += n;
+      b += n;
+    } break;
+    case REC_END:
+      // Back to ASCII for the bytes that follow. M576 S0 carries the "ok".
+      set_active(p, false);
+      strcpy_P(cmd, PSTR("M576 S0"));
+      return true;
+  }
+  *s = '\0';
+  pt.pos = b < end ? b - pt.frame : 0;
+  return !pt.pos;
+}
+
+#endif // BINARY_MOTION_PROTOCOL
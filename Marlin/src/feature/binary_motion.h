@@ -0,0 +1,94 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * binary_motion.h - Compact binary frames for streamed moves
+ *
+ * "M576 S1" switches the serial port it arrives on to binary frames:
+ *
+ *   SYNC | seq | len | payload[len] | crc16 (low byte first)
+ *
+ * Everything after SYNC is escaped: SYNC, ESC, '\n' and '\r' are sent as ESC
+ * followed by the byte XOR 0x20. A SYNC always starts a frame, and frames
+ * never hold a line end, so the emergency parser still sees a "\nM112\n"
+ * sent between frames. seq is the low byte of the line number the frame
+ * stands for (N in ASCII) and crc16 is CRC-CCITT (0xFFFF start) over seq,
+ * len and payload. Errors get the usual "Resend:" reply.
+ *
+ * The payload is one or more records, each with a header byte:
+ *
+ *   bits 0-1  0 = G1, 1 = G0, 2 = text, 3 = end of binary mode
+ *   bits 2-6  G0/G1: X Y Z E F follow, in that order
+ *
+ * X Y Z are deltas of the word value in µm, E in 10 nm, as zigzag LEB128
+ * varints. F is the absolute feedrate in mm/min, as a LEB128 varint. A text
+ * record is a length byte and a G-code line. An end record must come last.
+ *
+ * Each record becomes one text command in the command queue, and the last
+ * one of a frame sends its "ok".
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class BinaryMotion {
+public:
+  static constexpr uint8_t SYNC = 0xC0, ESC = 0xDB;
+
+  enum Result : uint8_t { NEED_MORE, FRAME_OK, BAD_CHECKSUM, BAD_FRAME };
+
+  static bool active(const uint8_t p) { return port[p].active; }
+  static void set_active(const uint8_t p, const bool onoff);
+
+  // Take one byte from the serial port
+  static Result receive(const uint8_t p, const uint8_t c);
+
+  // The line number of the last received frame, in 8 bits
+  static uint8_t frame_seq(const uint8_t p) { return port[p].frame[0]; }
+
+  // Accept the received frame, to queue its commands
+  static void accept(const uint8_t p) { port[p].pos = 2; }
+
+  // An accepted frame has records left
+  static bool pending(const uint8_t p) { return port[p].pos; }
+
+  // Write the next record as a command. True for the last one of the frame.
+  static bool next_command(const uint8_t p, char * const cmd);
+
+private:
+  enum State : uint8_t { HUNT, DATA, ESCAPED };
+
+  typedef struct {
+    bool active;
+    State state;
+    uint8_t count,            // Bytes received after SYNC
+            pos;              // Next record of an accepted frame. 0 = none.
+    int32_t word[XYZE + 1];   // Last X Y Z E word value and F
+    uint8_t frame[2 + BINARY_MOTION_FRAME_SIZE + 2];
+  } port_t;
+
+  static port_t port[NUM_SERIAL];
+
+  static bool validate(const port_t &pt);
+};
+
+extern BinaryMotion binary_motion;
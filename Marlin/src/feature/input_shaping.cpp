@@ -0,0 +1,85 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(INPUT_SHAPING)
+
+#include "input_shaping.h"
+
+PGM_P AxisShaper::type_name(const uint8_t type) {
+  switch (type) {
+    default:
+    case SHAPER_ZV:  return PSTR("ZV");
+    case SHAPER_ZVD: return PSTR("ZVD");
+    case SHAPER_EI:  return PSTR("EI");
+  }
+}
+
+/**
+ * Impulse shares and times for a resonance at frequency f with damping ratio zeta.
+ * With damped period Td = 1 / (f * sqrt(1 - zeta²)) and K = exp(-zeta * PI / sqrt(1 - zeta²)):
+ *
+ *   ZV:  1, K             at 0, Td/2
+ *   ZVD: 1, 2K, K²        at 0, Td/2, Td
+ *   EI:  a, (1-V)/2 K, a K² at 0, Td/2, Td    with a = (1+V)/4 and 5% vibration tolerance V
+ *
+ * scaled to add up to one step.
+ */
+void AxisShaper::apply(const bool active) {
+  enabled = active && settings.frequency > 0;
+  out_dir = 0;
+  head[0] = head[1] = tail = 0;
+  residue = 0;
+
+  if (!enabled) { echoes = 1; return; }
+
+  const float zeta = constrain(settings.zeta, 0, 0.99f),
+              root = SQRT(1 - sq(zeta)),
+              K = expf(-zeta * float(M_PI) / root),
+              half_period = 0.5f / (settings.frequency * root);
+
+  float a[3];
+  switch (settings.type) {
+    default:
+    case SHAPER_ZV:  echoes = 1; a[0] = 1; a[1] = K; a[2] = 0; break;
+    case SHAPER_ZVD: echoes = 2; a[0] = 1; a[1] = 2 * K; a[2] = sq(K); break;
+    case SHAPER_EI: {
+      constexpr float V = 0.05f;
+      echoes = 2;
+      a[0] = 0.25f * (1 + V);
+      a[1] = 0.5f * (1 - V) * K;
+      a[2] = a[0] * sq(K);
+    } break;
+  }
+
+  // Round the later shares and give the rest to the first, so they add up to exactly one step
+  const float scale = unit / (a[0] + a[1] + a[2]);
+  share[1] = LROUND(a[1] * scale);
+  share[2] = LROUND(a[2] * scale);
+  share[0] = unit - share[1] - share[2];
+
+  delay[0] = LROUND(half_period * (STEPPER_TIMER_RATE));
+  delay[1] = 2 * delay[0];
+}
+
+#endif // INPUT_SHAPING
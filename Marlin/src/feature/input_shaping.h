@@ -0,0 +1,117 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * input_shaping.h - Cancel an axis resonance by shaping its step stream
+ *
+ * Every step event of a shaped axis is split into two (ZV) or three (ZVD, EI)
+ * impulses spread over one damped period of the resonance. Their shares are
+ * chosen so the vibrations they excite cancel out. The output steps follow the
+ * running sum of the impulses, rounded to whole steps, so the axis still ends
+ * up exactly where the planner put it.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum ShaperType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_EI };
+
+typedef struct {
+  uint8_t type;               // ShaperType
+  float frequency,            // (Hz) Resonance to cancel. 0 to disable.
+        zeta;                 // Damping ratio of the resonance
+} shaping_settings_t;
+
+class AxisShaper {
+public:
+  static constexpr int32_t unit = _BV32(16);          // One step, in impulse share units
+  static constexpr uint32_t never = UINT32_MAX;
+
+  shaping_settings_t settings;
+  bool enabled;               // Shaping the output (frequency set and not paused)
+  int8_t out_dir;             // Direction the motor is set to: 1, -1, or 0 if not known
+  uint32_t overflows;         // Step events output unshaped for lack of queue space
+
+  // Set up the impulses for the settings. Only with the queue empty and the ISR held off.
+  void apply(const bool active);
+
+  static PGM_P type_name(const uint8_t type);
+
+  // Step events still waiting on an impulse
+  FORCE_INLINE bool busy() const { return head[echoes - 1] != tail; }
+
+  // A step event of the axis at 'now' (in Stepper timer ticks). Return the output step.
+  FORCE_INLINE int8_t add(const uint32_t now, const bool reverse) {
+    uint16_t next_tail = tail + 1;
+    if (next_tail == SHAPING_BUFFER_SIZE) next_tail = 0;
+    if (next_tail == head[echoes - 1]) {
+      residue += reverse ? -unit : unit;              // No room. Take the whole step now.
+      overflows++;
+    }
+    else {
+      residue += reverse ? -share[0] : share[0];
+      events[tail] = (now & ~1UL) | reverse;
+      tail = next_tail;
+    }
+    return output();
+  }
+
+  // Take the next impulse that is due at 'now'. Return false if none is due.
+  FORCE_INLINE bool echo(const uint32_t now, int8_t &step) {
+    LOOP_L_N(e, echoes) {
+      const uint16_t h = head[e];
+      if (h == tail) continue;
+      const uint32_t ev = events[h];
+      if (int32_t(now - (ev & ~1UL) - delay[e]) < 0) continue;
+      head[e] = h + 1 == SHAPING_BUFFER_SIZE ? 0 : h + 1;
+      residue += TEST(ev, 0) ? -share[e + 1] : share[e + 1];
+      step = output();
+      return true;
+    }
+    return false;
+  }
+
+  // Ticks from 'now' until the next impulse is due
+  FORCE_INLINE uint32_t next(const uint32_t now) const {
+    uint32_t ticks = never;
+    LOOP_L_N(e, echoes) if (head[e] != tail) {
+      const int32_t left = int32_t((events[head[e]] & ~1UL) + delay[e] - now);
+      NOMORE(ticks, left > 0 ? uint32_t(left) : 0UL);
+    }
+    return ticks;
+  }
+
+private:
+  uint8_t echoes = 1;         // Impulses after the first: 1 (ZV) or 2 (ZVD, EI)
+  uint32_t delay[2];          // (ticks) From a step event to each later impulse
+  int32_t share[3];           // Share of a step in each impulse, summing to 'unit'
+  int32_t residue;            // Shaped position minus output position
+  uint16_t head[2], tail;     // Next event for each later impulse, next free event
+  uint32_t events[SHAPING_BUFFER_SIZE]; // Step event times. Bit 0 set for reverse steps.
+
+  // A whole step once the shaped position is half a step away
+  FORCE_INLINE int8_t output() {
+    if (residue >= unit / 2) { residue -= unit; return 1; }
+    if (residue < -unit / 2) { residue += unit; return -1; }
+    return 0;
+  }
+};
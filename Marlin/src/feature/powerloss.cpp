@@ -36,9 +36,15 @@ bool PrintJobRecovery::enabled; // Initialized by settings.load()
 SdFile PrintJobRecovery::file;
 job_recovery_info_t PrintJobRecovery::info;
 const char PrintJobRecovery::filename[5] = "/PLR";
-uint8_t PrintJobRecovery::queue_index_r;
 uint32_t PrintJobRecovery::cmd_sdpos, // = 0
-         PrintJobRecovery::sdpos[BUFSIZE];
+         PrintJobRecovery::queue_sdpos;
+
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #define PLR_JOURNAL_MAGIC 0x4A524C50UL  // "PLRJ"
+  static_assert(sizeof(plr_record_t) <= 512, "The power-loss data must fit in one block for POWER_LOSS_JOURNAL.");
+  uint32_t PrintJobRecovery::journal_block, // = 0
+           PrintJobRecovery::journal_number;
+#endif
 
 #if ENABLED(DWIN_CREALITY_LCD)
   bool PrintJobRecovery::dwin_flag; // = false
@@ -61,6 +67,10 @@ uint32_t PrintJobRecovery::cmd_sdpos, // = 0
 #define DEBUG_OUT ENABLED(DEBUG_POWER_LOSS_RECOVERY)
 #include "../core/debug_out.h"
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "../libs/crc16.h"
+#endif
+
 PrintJobRecovery recovery;
 
 #ifndef POWER_LOSS_PURGE_LEN
@@ -138,7 +148,11 @@ void PrintJobRecovery::purge() {
 void PrintJobRecovery::load() {
   if (exists()) {
     open(true);
-    (void)file.read(&info, sizeof(info));
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      if (!journal_scan(&info)) init();
+    #else
+      (void)file.read(&info, sizeof(info));
+    #endif
     close();
   }
   debug(PSTR("Load"));
@@ -295,6 +309,9 @@ void PrintJobRecovery::save(const bool force/*=false*/, const float zraise/*=0*/
     // Save, including the limited Z raise
     if (IS_SD_PRINTING()) save(true, zraise);
 
+    // Get it onto the card before the power is gone
+    TERN_(SD_WRITE_BEHIND, SdWriteQueue::flush());
+
     // Disable all heaters to reduce power loss
     thermalManager.disable_all_heaters();
 
@@ -317,13 +334,67 @@ void PrintJobRecovery::write() {
 
   debug(PSTR("Write"));
 
-  open(false);
-  file.seekSet(0);
-  const int16_t ret = file.write(&info, sizeof(info));
-  if (ret == -1) DEBUG_ECHOLNPGM("Power-loss file write failed.");
-  if (!file.close()) DEBUG_ECHOLNPGM("Power-loss file close failed.");
+  #if ENABLED(POWER_LOSS_JOURNAL)
+
+    if (!journal_block && !journal_open()) {
+      DEBUG_ECHOLNPGM("Power-loss journal open failed.");
+      return;
+    }
+
+    // The next record, into the oldest slot
+    plr_record_t rec;
+    rec.magic = PLR_JOURNAL_MAGIC;
+    rec.number = ++journal_number;
+    rec.info = info;
+    rec.crc = 0;
+    crc16(&rec.crc, &rec, offsetof(plr_record_t, crc));
+    if (!card.writeJobRecoveryBlock(journal_block + rec.number % (POWER_LOSS_JOURNAL_SLOTS), &rec, sizeof(rec)))
+      DEBUG_ECHOLNPGM("Power-loss file write failed.");
+
+  #else
+
+    open(false);
+    file.seekSet(0);
+    const int16_t ret = file.write(&info, sizeof(info));
+    if (ret == -1) DEBUG_ECHOLNPGM("Power-loss file write failed.");
+    if (!file.close()) DEBUG_ECHOLNPGM("Power-loss file close failed.");
+
+  #endif
 }
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+  /**
+   * Open the journal for the job, carrying on from its newest record
+   */
+  bool PrintJobRecovery::journal_open() {
+    bool fresh;
+    journal_block = card.openJobRecoveryJournal(fresh);
+    if (journal_block) journal_number = fresh ? 0 : journal_scan(nullptr);
+    return journal_block;
+  }
+
+  /**
+   * Read every record of the open journal. Copy the newest good one to 'newest'.
+   * Return its number, or 0 if there is none.
+   */
+  uint32_t PrintJobRecovery::journal_scan(job_recovery_info_t * const newest) {
+    plr_record_t rec;
+    uint32_t number = 0;
+    for (uint16_t i = 0; i < POWER_LOSS_JOURNAL_SLOTS; i++) {
+      if (!file.seekSet(i * 512UL) || file.read(&rec, sizeof(rec)) != sizeof(rec)) break;
+      if (rec.magic != PLR_JOURNAL_MAGIC || rec.number <= number) continue;
+      uint16_t crc = 0;
+      crc16(&crc, &rec, offsetof(plr_record_t, crc));
+      if (crc != rec.crc) continue;   // Cut off as it was written
+      number = rec.number;
+      if (newest) *newest = rec.info;
+    }
+    return number;
+  }
+
+#endif
+
 /**
  * Resume the saved print job
  */
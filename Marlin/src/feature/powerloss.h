@@ -113,6 +113,16 @@ typedef struct {
 
 } job_recovery_info_t;
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  // A record of the journal, at the start of its block
+  typedef struct {
+    uint32_t magic,               // PLR_JOURNAL_MAGIC
+             number;              // Records are numbered from 1, newest highest
+    job_recovery_info_t info;
+    uint16_t crc;                 // Of all the above
+  } plr_record_t;
+#endif
+
 class PrintJobRecovery {
   public:
     static const char filename[5];
@@ -120,9 +130,8 @@ class PrintJobRecovery {
     static SdFile file;
     static job_recovery_info_t info;
 
-    static uint8_t queue_index_r;     //!< Queue index of the active command
     static uint32_t cmd_sdpos,        //!< SD position of the next command
-                    sdpos[BUFSIZE];   //!< SD positions of queued commands
+                    queue_sdpos;      //!< SD position of the active command
 
     #if ENABLED(DWIN_CREALITY_LCD)
       static bool dwin_flag;
@@ -145,9 +154,8 @@ class PrintJobRecovery {
       #endif
     }
 
-    // Track each command's file offsets
-    static inline uint32_t command_sdpos() { return sdpos[queue_index_r]; }
-    static inline void commit_sdpos(const uint8_t index_w) { sdpos[index_w] = cmd_sdpos; }
+    // Track each command's file offsets. The queue keeps them with the commands.
+    static inline uint32_t command_sdpos() { return queue_sdpos; }
 
     static bool enabled;
     static void enable(const bool onoff);
@@ -155,7 +163,7 @@ class PrintJobRecovery {
 
     static inline bool exists() { return card.jobRecoverFileExists(); }
     static inline void open(const bool read) { card.openJobRecoveryFile(read); }
-    static inline void close() { file.close(); }
+    static inline void close() { file.close(); TERN_(POWER_LOSS_JOURNAL, journal_block = 0); }
 
     static void check();
     static void resume();
@@ -184,6 +192,13 @@ class PrintJobRecovery {
   private:
     static void write();
 
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      static uint32_t journal_block,  //!< First block of the open journal. 0 = closed.
+                      journal_number; //!< Number of the newest record
+      static bool journal_open();
+      static uint32_t journal_scan(job_recovery_info_t * const newest);
+    #endif
+
     #if ENABLED(BACKUP_POWER_SUPPLY)
       static void retract_and_lift(const float &zraise);
     #endif
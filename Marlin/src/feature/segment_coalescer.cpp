@@ -0,0 +1,148 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * segment_coalescer.cpp - Fuse short collinear moves before they reach the planner
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SEGMENT_COALESCING)
+
+#include "segment_coalescer.h"
+#include "../module/planner.h"
+
+SegmentCoalescer coalescer;
+
+bool SegmentCoalescer::enabled = true;
+float SegmentCoalescer::chord_tolerance = COALESCE_CHORD_TOLERANCE,
+      SegmentCoalescer::angle_tolerance = COALESCE_ANGLE_TOLERANCE,
+      SegmentCoalescer::cos_tolerance = cos(RADIANS(COALESCE_ANGLE_TOLERANCE)),
+      SegmentCoalescer::e_per_mm;
+uint32_t SegmentCoalescer::segments, SegmentCoalescer::merged, SegmentCoalescer::blocks;
+
+uint8_t SegmentCoalescer::held;
+xyze_pos_t SegmentCoalescer::start, SegmentCoalescer::end;
+xyz_pos_t SegmentCoalescer::points[COALESCE_MAX_SEGMENTS - 1];
+xyz_float_t SegmentCoalescer::last_dir;
+feedRate_t SegmentCoalescer::feedrate;
+uint8_t SegmentCoalescer::held_extruder;
+millis_t SegmentCoalescer::held_ms;
+
+void SegmentCoalescer::set_angle_tolerance(const float deg) {
+  angle_tolerance = deg;
+  cos_tolerance = cos(RADIANS(deg));
+}
+
+/**
+ * Queue a linear move to 'target', merging it with the held move if it
+ * continues in the same direction. The planner gets the held move first
+ * whenever the new segment can't be merged.
+ */
+void SegmentCoalescer::line_to(const xyze_pos_t &target, const feedRate_t &fr_mm_s, const uint8_t extruder) {
+  segments++;
+
+  const xyze_pos_t &from = held ? end : current_position;
+  const xyz_float_t dist = xyz_pos_t(target) - xyz_pos_t(from);
+  const float length = dist.magnitude();
+
+  // Long moves and E / zero-length moves go straight to the planner
+  if (!enabled || length > COALESCE_MAX_SEGMENT_MM || length < 0.0001f) {
+    flush();
+    planner.buffer_line(target, fr_mm_s, extruder);
+    return;
+  }
+
+  const float inv_length = 1.0f / length;
+  const xyz_float_t dir = dist * inv_length;
+  const float e_ratio = (target.e - from.e) * inv_length;
+
+  if (held && fr_mm_s == feedrate && extruder == held_extruder && fits(target, dir, e_ratio)) {
+    points[held - 1] = end;
+    held++;
+    merged++;
+  }
+  else {
+    flush();
+    start = from;
+    feedrate = fr_mm_s;
+    held_extruder = extruder;
+    e_per_mm = e_ratio;
+    held_ms = millis();
+    held = 1;
+  }
+  end = target;
+  last_dir = dir;
+}
+
+/**
+ * Check whether the held move can be extended to 'target':
+ *  - There's room for another point
+ *  - The direction changes less than the angle tolerance
+ *  - The extrusion per mm is about the same
+ *  - All the held points stay within the chord tolerance of the new move
+ */
+bool SegmentCoalescer::fits(const xyze_pos_t &target, const xyz_float_t &dir, const float e_ratio) {
+  if (held >= COALESCE_MAX_SEGMENTS) return false;
+
+  if (dir.x * last_dir.x + dir.y * last_dir.y + dir.z * last_dir.z < cos_tolerance) return false;
+
+  if (ABS(e_ratio - e_per_mm) > COALESCE_E_TOLERANCE * ABS(e_per_mm) + 0.00001f) return false;
+
+  // Distance of each point from the line start -> target
+  const xyz_float_t chord = xyz_pos_t(target) - xyz_pos_t(start);
+  const float chord_len_sq = chord.x * chord.x + chord.y * chord.y + chord.z * chord.z,
+              max_sq = sq(chord_tolerance) * chord_len_sq;
+
+  auto within = [&](const xyz_pos_t &p) {
+    const xyz_float_t v = p - xyz_pos_t(start);
+    const float cx = v.y * chord.z - v.z * chord.y,
+                cy = v.z * chord.x - v.x * chord.z,
+                cz = v.x * chord.y - v.y * chord.x;
+    return cx * cx + cy * cy + cz * cz <= max_sq;   // |v × chord|² <= (tolerance · |chord|)²
+  };
+
+  LOOP_L_N(i, held - 1) if (!within(points[i])) return false;
+  return within(end);
+}
+
+void SegmentCoalescer::deliver() {
+  held = 0;
+  blocks++;
+  planner.buffer_line(end, feedrate, held_extruder);
+}
+
+void SegmentCoalescer::idle() {
+  if (held && (!planner.has_blocks_queued() || ELAPSED(millis(), held_ms + COALESCE_HOLD_MS)))
+    deliver();
+}
+
+void SegmentCoalescer::report() {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Segment coalescing S", int(enabled));
+  SERIAL_ECHOPAIR_F(" C", chord_tolerance, 3);
+  SERIAL_ECHOLNPAIR_F(" A", angle_tolerance, 1);
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("Segments:", segments, " Merged:", merged, " Blocks:", blocks);
+}
+
+#endif // SEGMENT_COALESCING
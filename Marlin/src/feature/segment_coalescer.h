@@ -0,0 +1,75 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * segment_coalescer.h - Fuse short collinear moves before they reach the planner
+ *
+ * Cartesian G1 moves are held here instead of going straight to
+ * Planner::buffer_line. Each following segment that continues in the same
+ * direction is appended to the held move, which is delivered as one planner
+ * block when a segment doesn't fit, another move or command comes along,
+ * or the planner is about to run dry.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class SegmentCoalescer {
+public:
+  static bool enabled;
+  static float chord_tolerance,   // (mm)
+               angle_tolerance;   // (°)
+
+  static uint32_t segments,       // G1 segments received
+                  merged,         // Segments fused into a previous one
+                  blocks;         // Held moves delivered to the planner
+
+  static void line_to(const xyze_pos_t &target, const feedRate_t &fr_mm_s, const uint8_t extruder);
+
+  // Deliver the held move to the planner
+  static inline void flush() { if (held) deliver(); }
+
+  // Drop the held move (e.g., on quick stop)
+  static inline void discard() { held = 0; }
+
+  // Deliver the held move before the planner runs dry
+  static void idle();
+
+  static void set_angle_tolerance(const float deg);
+  static void reset() { segments = merged = blocks = 0; }
+  static void report();
+
+private:
+  static uint8_t held;                                // Number of segments in the held move
+  static xyze_pos_t start, end;                       // The held move
+  static xyz_pos_t points[COALESCE_MAX_SEGMENTS - 1]; // Intermediate points of the held move
+  static xyz_float_t last_dir;                        // Direction of the last held segment
+  static float e_per_mm, cos_tolerance;
+  static feedRate_t feedrate;
+  static uint8_t held_extruder;
+  static millis_t held_ms;
+
+  static void deliver();
+  static bool fits(const xyze_pos_t &target, const xyz_float_t &dir, const float e_ratio);
+};
+
+extern SegmentCoalescer coalescer;
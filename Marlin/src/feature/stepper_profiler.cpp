@@ -0,0 +1,100 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * stepper_profiler.cpp - Measure the Stepper ISR phases in CPU cycles
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILER)
+
+#include "stepper_profiler.h"
+#include "../module/stepper.h"
+
+#ifndef HAL_CYCLE_FREQUENCY
+  #define HAL_CYCLE_FREQUENCY F_CPU
+#endif
+
+StepperProfiler stepper_profiler;
+
+StepperProfiler::stats_t StepperProfiler::stats[PHASE_COUNT];
+
+void StepperProfiler::init() {
+  HAL_cycle_counter_init();
+  reset();
+}
+
+void StepperProfiler::reset() {
+  const bool was_on = stepper.suspend();
+  LOOP_L_N(p, PHASE_COUNT) {
+    stats[p] = {};
+    stats[p].min = UINT32_MAX;
+  }
+  if (was_on) stepper.wake_up();
+}
+
+static void report_phase(PGM_P const name, const StepperProfiler::stats_t &s, const uint32_t estimate) {
+  serialprintPGM(name);
+  if (!s.count) { SERIAL_ECHOLNPGM(" -"); return; }
+  const uint32_t avg = s.total / s.count;
+  SERIAL_ECHOPAIR(" n:", s.count, " min:", s.min, " avg:", avg, " max:", s.max);
+  if (estimate) SERIAL_ECHOPAIR(" est:", estimate);
+  SERIAL_EOL();
+
+  SERIAL_ECHOPGM(" hist");
+  LOOP_L_N(b, StepperProfiler::HISTOGRAM_BINS) if (s.histogram[b])
+    SERIAL_ECHOPAIR(" <", 64UL << b, ":", s.histogram[b]);
+  SERIAL_EOL();
+}
+
+void StepperProfiler::report() {
+  // Take a consistent snapshot while the Stepper ISR is held off
+  static stats_t snap[PHASE_COUNT];
+  const bool was_on = stepper.suspend();
+  LOOP_L_N(p, PHASE_COUNT) snap[p] = stats[p];
+  if (was_on) stepper.wake_up();
+
+  const uint32_t hz = HAL_CYCLE_FREQUENCY;
+  SERIAL_ECHOLNPAIR("Stepper ISR profile (cycles @ ", hz, "Hz)");
+  report_phase(PSTR("isr     "), snap[PHASE_ISR], ISR_EXECUTION_CYCLES(1));
+  report_phase(PSTR("pulse   "), snap[PHASE_PULSE], ISR_LOOP_CYCLES);
+  report_phase(PSTR("block   "), snap[PHASE_BLOCK], ISR_BASE_CYCLES + ISR_S_CURVE_CYCLES);
+  #if ENABLED(LIN_ADVANCE)
+    report_phase(PSTR("advance "), snap[PHASE_ADVANCE], ISR_LA_BASE_CYCLES + ISR_LA_LOOP_CYCLES);
+  #endif
+  #if ENABLED(INTEGRATED_BABYSTEPPING)
+    report_phase(PSTR("babystep"), snap[PHASE_BABYSTEP], 0);
+  #endif
+  #if ENABLED(INPUT_SHAPING)
+    report_phase(PSTR("shaping "), snap[PHASE_SHAPING], 0);
+  #endif
+
+  // Step rate the measured ISR could sustain, against the stepper.h estimate
+  const stats_t &isr = snap[PHASE_ISR];
+  if (isr.count) {
+    const uint32_t avg = isr.total / isr.count;
+    SERIAL_ECHOLNPAIR("Max 1x step rate measured:", hz / _MAX(avg, 1UL), "Hz worst:", hz / _MAX(isr.max, 1UL), "Hz est:", uint32_t(MAX_STEP_ISR_FREQUENCY_1X), "Hz");
+  }
+}
+
+#endif // STEPPER_ISR_PROFILER
@@ -0,0 +1,92 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * stepper_profiler.h - Measure the Stepper ISR phases in CPU cycles
+ *
+ * Uses the HAL cycle counter (DWT CYCCNT on LPC1768, TSC on LINUX) to collect
+ * min / avg / max and a log2 histogram for the whole ISR and each of its phases,
+ * so the ISR_*_CYCLES estimates in stepper.h can be checked against real hardware.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class StepperProfiler {
+public:
+  enum Phase : uint8_t {
+    PHASE_ISR,        // Whole Stepper::isr() call
+    PHASE_PULSE,      // pulse_phase_isr()
+    PHASE_BLOCK,      // block_phase_isr()
+    PHASE_ADVANCE,    // advance_isr()
+    PHASE_BABYSTEP,   // babystepping_isr()
+    PHASE_SHAPING,    // shaping_isr()
+    PHASE_COUNT
+  };
+
+  // Bin 0 counts samples under 64 cycles, bin n (n > 0) samples in [32 << n, 64 << n).
+  // The last bin also collects everything above its range.
+  static constexpr uint8_t HISTOGRAM_BINS = 16;
+
+  typedef struct {
+    uint32_t count, min, max;
+    uint64_t total;
+    uint32_t histogram[HISTOGRAM_BINS];
+  } stats_t;
+
+  static stats_t stats[PHASE_COUNT];
+
+  static void init();
+  static void reset();
+  static void report();
+
+  // Called from the Stepper ISR only
+  static inline void record(const Phase p, const uint32_t cycles) {
+    stats_t &s = stats[p];
+    if (s.count == UINT32_MAX) return;  // Saturated. Reset to continue.
+    s.count++;
+    s.total += cycles;
+    NOMORE(s.min, cycles);
+    NOLESS(s.max, cycles);
+    s.histogram[bin(cycles)]++;
+  }
+
+  static inline uint8_t bin(const uint32_t cycles) {
+    if (cycles < 64) return 0;
+    const uint8_t b = (31 - __builtin_clz(cycles)) - 5;
+    return _MIN(b, HISTOGRAM_BINS - 1);
+  }
+
+  // Measure the enclosing scope
+  class Scope {
+  public:
+    Scope(const Phase p) : phase(p), start(HAL_cycle_count()) {}
+    ~Scope() { record(phase, HAL_cycle_count() - start); }
+  private:
+    const Phase phase;
+    const uint32_t start;
+  };
+};
+
+extern StepperProfiler stepper_profiler;
+
+#define PROFILE_STEPPER_PHASE(P) StepperProfiler::Scope _stepper_profile_##P(StepperProfiler::PHASE_##P)
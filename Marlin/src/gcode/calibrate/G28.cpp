@@ -238,6 +238,9 @@ void GcodeSuite::G28() {
 
   TERN_(CNC_WORKSPACE_PLANES, workspace_plane = PLANE_XY);
 
+  // Home without input shaping so the axes stop where the endstops trigger
+  TERN_(INPUT_SHAPING, stepper.pause_shaping(true));
+
   // Count this command as movement / activity
   reset_stepper_timeout();
 
@@ -422,6 +425,8 @@ void GcodeSuite::G28() {
 
   endstops.not_homing();
 
+  TERN_(INPUT_SHAPING, stepper.pause_shaping(false));
+
   // Clear endstop state for polled stallGuard endstops
   TERN_(SPI_ENDSTOPS, endstops.clear_endstop_state());
 
@@ -35,6 +35,7 @@
 #include "../../module/planner.h"
 #include "../../module/tool_change.h"
 #include "../../module/endstops.h"
+#include "../../module/stepper.h"
 #include "../../feature/bedlevel/bedlevel.h"
 
 #if !AXIS_CAN_CALIBRATE(X)
@@ -588,6 +589,9 @@ void GcodeSuite::G425() {
 
   measurements_t m;
 
+  // Probe without input shaping so the axes stop where the object is touched
+  TERN_(INPUT_SHAPING, stepper.pause_shaping(true));
+
   float uncertainty = parser.seenval('U') ? parser.value_float() : CALIBRATION_MEASUREMENT_UNCERTAIN;
 
   if (parser.seen('B'))
@@ -612,6 +616,8 @@ void GcodeSuite::G425() {
   else
     calibrate_all();
 
+  TERN_(INPUT_SHAPING, stepper.pause_shaping(false));
+
   #ifdef CALIBRATION_SCRIPT_POST
     GcodeSuite::process_subcommands_now_P(PSTR(CALIBRATION_SCRIPT_POST));
   #endif
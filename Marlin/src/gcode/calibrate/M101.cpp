@@ -19,22 +19,25 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  *
  */
-#pragma once
 
-#include <mutex>
-#include <list>
-#include <fstream>
-#include "Gpio.h"
+#include "../../inc/MarlinConfigPre.h"
 
-class IOLoggerCSV: public IOLogger {
-public:
-  IOLoggerCSV(std::string filename);
-  virtual ~IOLoggerCSV();
-  void flush();
-  void log(GpioEvent ev);
+#if ENABLED(GCODE_PROFILER)
 
-private:
-  std::ofstream file;
-  std::list<GpioEvent> events;
-  std::mutex vector_lock;
-};
+#include "../gcode.h"
+
+/**
+ * M101: Report G-code dispatch statistics
+ *
+ *   R   Reset the statistics after reporting
+ *
+ * Lists every command run since the last reset, the most time-consuming
+ * first, with its number of calls, total and average time in the handler,
+ * and its share of the total.
+ */
+void GcodeSuite::M101() {
+  report_command_stats();
+  if (parser.seen('R')) reset_command_stats();
+}
+
+#endif // GCODE_PROFILER
@@ -19,31 +19,25 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  *
  */
-#ifdef __PLAT_LINUX__
 
-#include "IOLoggerCSV.h"
+#include "../../inc/MarlinConfigPre.h"
 
-IOLoggerCSV::IOLoggerCSV(std::string filename) {
-  file.open(filename);
-}
-
-IOLoggerCSV::~IOLoggerCSV() {
-  file.close();
-}
+#if ENABLED(STEPPER_ISR_PROFILER)
 
-void IOLoggerCSV::log(GpioEvent ev) {
-  std::lock_guard<std::mutex> lock(vector_lock);
-  events.push_back(ev); //minimal impact to signal handler
-}
+#include "../gcode.h"
+#include "../../feature/stepper_profiler.h"
 
-void IOLoggerCSV::flush() {
-  { std::lock_guard<std::mutex> lock(vector_lock);
-    while (!events.empty()) {
-      file << events.front().timestamp << ", "<< events.front().pin_id << ", " << events.front().event << std::endl;
-      events.pop_front();
-    }
-  }
-  file.flush();
+/**
+ * M124: Report the Stepper ISR cycle profile
+ *
+ *   R   Reset the statistics after reporting
+ *
+ * For each ISR phase reports the number of samples, min / avg / max cycles,
+ * the stepper.h estimate, and the non-empty bins of the log2 histogram.
+ */
+void GcodeSuite::M124() {
+  stepper_profiler.report();
+  if (parser.seen('R')) stepper_profiler.reset();
 }
 
-#endif // __PLAT_LINUX__
+#endif // STEPPER_ISR_PROFILER
@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+
+#include "../gcode.h"
+#include "../queue.h"
+#include "../../feature/binary_motion.h"
+
+/**
+ * M576 - Binary motion protocol
+ *
+ *   S1 - Switch the serial port to binary frames
+ *   S0 - Back to text lines
+ *
+ * The switch is made as soon as the line is received, so frames may follow
+ * without waiting for the "ok". An end record in a frame switches back.
+ * Here only the state of the port is reported.
+ */
+void GcodeSuite::M576() {
+  const int16_t port = queue.command_port();
+  if (port < 0) return;
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPGM("Binary motion ");
+  serialprint_onoff(binary_motion.active(port));
+  SERIAL_ECHOLNPAIR(" frame:", BINARY_MOTION_FRAME_SIZE);
+}
+
+#endif // BINARY_MOTION_PROTOCOL
@@ -0,0 +1,78 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(INPUT_SHAPING)
+
+#include "../../gcode.h"
+#include "../../../module/stepper.h"
+
+void M593_report(const bool forReplay=true) {
+  LOOP_L_N(a, 2) {
+    const AxisShaper &s = stepper.shaper[a];
+    if (!forReplay) SERIAL_ECHO_START();
+    SERIAL_ECHOPGM("  M593 ");
+    SERIAL_CHAR(XYZ_CHAR(a));
+    SERIAL_ECHOPAIR_F(" F", s.settings.frequency, 2);
+    SERIAL_ECHOPAIR_F(" D", s.settings.zeta, 3);
+    SERIAL_ECHOPAIR(" T", int(s.settings.type), " ; ");
+    serialprintPGM(AxisShaper::type_name(s.settings.type));
+    if (s.overflows) SERIAL_ECHOPAIR(" overflows:", s.overflows);
+    SERIAL_EOL();
+  }
+}
+
+/**
+ * M593: Set the input shaper of X and Y
+ *
+ *   X        Set X. Without X or Y, set both.
+ *   Y        Set Y
+ *   F<hz>    Frequency of the resonance to cancel. 0 to disable shaping.
+ *   D<zeta>  Damping ratio of the resonance (0 to 0.5)
+ *   T<type>  Shaper: 0 = ZV, 1 = ZVD, 2 = EI
+ *
+ * Type M593 without any arguments to show the shapers.
+ * Waits for all moves to finish before it changes a shaper.
+ */
+void GcodeSuite::M593() {
+  if (!parser.seen("FDT")) return M593_report(false);
+
+  if (parser.seenval('F')) {
+    const float f = parser.value_float();
+    if (f && !WITHIN(f, SHAPING_MIN_FREQ, SHAPING_MAX_FREQ)) {
+      SERIAL_ECHOLNPGM("?F out of range (" STRINGIFY(SHAPING_MIN_FREQ) " to " STRINGIFY(SHAPING_MAX_FREQ) ")");
+      return;
+    }
+  }
+
+  const bool seen_x = parser.seen('X'), seen_y = parser.seen('Y'), both = !seen_x && !seen_y;
+  LOOP_L_N(a, 2) if (both || (a == X_AXIS ? seen_x : seen_y)) {
+    shaping_settings_t s = stepper.shaper[a].settings;
+    if (parser.seenval('F')) s.frequency = parser.value_float();
+    if (parser.seenval('D')) s.zeta = constrain(parser.value_float(), 0, 0.5f);
+    if (parser.seenval('T')) s.type = _MIN(parser.value_byte(), uint8_t(SHAPER_EI));
+    stepper.set_shaping(AxisEnum(a), s);
+  }
+}
+
+#endif // INPUT_SHAPING
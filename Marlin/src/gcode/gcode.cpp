@@ -61,6 +61,10 @@ GcodeSuite gcode;
   #include "../feature/password/password.h"
 #endif
 
+#if ENABLED(SEGMENT_COALESCING)
+  #include "../feature/segment_coalescer.h"
+#endif
+
 #include "../MarlinCore.h" // for idle()
 
 // Inactivity shutdown
@@ -239,705 +243,916 @@ void GcodeSuite::dwell(millis_t time) {
   extern void M100_dump_routine(PGM_P const title, const char * const start, const char * const end);
 #endif
 
+// Dispatch key: letter, number (up to GCODE_KEY_MAX_N) and subcode
+#define GCODE_KEY(L, N, S) (uint32_t(L) << 24 | uint32_t(N) << 4 | (S))
+#define GCODE_KEY_MAX_N 0xFFFFF
+
 /**
- * Process the parsed command and dispatch it to its handler
+ * G- and M-code dispatch table
+ *
+ * Entries are sorted by key (letter, number, subcode) so any command is found
+ * with a binary search. G0-G3 come first so motion commands are looked up by
+ * number alone. An entry with no subcode also takes the subcodes that have no
+ * entry of their own (e.g., G59.1), and a null handler marks a command that is
+ * accepted but handled elsewhere (e.g., M108 with EMERGENCY_PARSER).
  */
-void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
-  KEEPALIVE_STATE(IN_HANDLER);
+struct GcodeSuite::Dispatch {
 
- /**
-  * Block all Gcodes except M511 Unlock Printer, if printer is locked
-  * Will still block Gcodes if M511 is disabled, in which case the printer should be unlocked via LCD Menu
-  */
-  #if ENABLED(PASSWORD_FEATURE)
-    if (password.is_locked && !(parser.command_letter == 'M' && parser.codenum == 511)) {
-      SERIAL_ECHO_MSG(STR_PRINTER_LOCKED);
-      return;
-    }
+  typedef void (*handler_t)();
+  typedef struct { uint32_t key; handler_t handler; } entry_t;
+
+  // Set by a handler that sends its own "ok" (or must not send one)
+  static bool skip_ok;
+
+  // Adapters for handlers that take arguments or answer the host themselves
+  static void G0() {
+    G0_G1(
+      #if IS_SCARA || defined(G0_FEEDRATE)
+        true
+      #endif
+    );
+  }
+  static void G1() { G0_G1(); }
+  #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+    static void G2() { G2_G3(true); }
+    static void G3() { G2_G3(false); }
+  #endif
+  TERN_(G38_PROBE_TARGET, static void G38() { GcodeSuite::G38(parser.subcode); });
+  static void G90() { set_relative_mode(false); }
+  static void G91() { set_relative_mode(true); }
+  #if HAS_CUTTER
+    static void M3() { M3_M4(false); }
+    static void M4() { M3_M4(true); }
+  #endif
+  static void M105() { GcodeSuite::M105(); skip_ok = true; }
+  #if ENABLED(MORGAN_SCARA)
+    static void M360() { if (GcodeSuite::M360()) skip_ok = true; }
+    static void M361() { if (GcodeSuite::M361()) skip_ok = true; }
+    static void M362() { if (GcodeSuite::M362()) skip_ok = true; }
+    static void M363() { if (GcodeSuite::M363()) skip_ok = true; }
+    static void M364() { if (GcodeSuite::M364()) skip_ok = true; }
   #endif
 
-  // Handle a known G, M, or T
-  switch (parser.command_letter) {
-    case 'G': switch (parser.codenum) {
+  #define _G(N, H)      { GCODE_KEY('G', N, 0), H }
+  #define _GS(N, S, H)  { GCODE_KEY('G', N, S), H }
+  #define _M(N, H)      { GCODE_KEY('M', N, 0), H }
 
-      case 0: case 1: G0_G1(                                      // G0: Fast Move, G1: Linear Move
-                        #if IS_SCARA || defined(G0_FEEDRATE)
-                          parser.codenum == 0
-                        #endif
-                      );
-                      break;
+  static constexpr entry_t table[] PROGMEM = {
 
-      #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
-        case 2: case 3: G2_G3(parser.codenum == 2); break;        // G2: CW ARC, G3: CCW ARC
-      #endif
+    _G(0, G0),                                                    // G0: Fast Move
+    _G(1, G1),                                                    // G1: Linear Move
 
-      case 4: G4(); break;                                        // G4: Dwell
+    #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+      _G(2, G2),                                                  // G2: CW ARC
+      _G(3, G3),                                                  // G3: CCW ARC
+    #endif
 
-      #if ENABLED(BEZIER_CURVE_SUPPORT)
-        case 5: G5(); break;                                      // G5: Cubic B_spline
-      #endif
+    _G(4, G4),                                                    // G4: Dwell
 
-      #if ENABLED(DIRECT_STEPPING)
-        case 6: G6(); break;                                      // G6: Direct Stepper Move
-      #endif
+    #if ENABLED(BEZIER_CURVE_SUPPORT)
+      _G(5, G5),                                                  // G5: Cubic B_spline
+    #endif
 
-      #if ENABLED(FWRETRACT)
-        case 10: G10(); break;                                    // G10: Retract / Swap Retract
-        case 11: G11(); break;                                    // G11: Recover / Swap Recover
-      #endif
+    #if ENABLED(DIRECT_STEPPING)
+      _G(6, G6),                                                  // G6: Direct Stepper Move
+    #endif
 
-      #if ENABLED(NOZZLE_CLEAN_FEATURE)
-        case 12: G12(); break;                                    // G12: Nozzle Clean
-      #endif
+    #if ENABLED(FWRETRACT)
+      _G(10, G10),                                                // G10: Retract / Swap Retract
+      _G(11, G11),                                                // G11: Recover / Swap Recover
+    #endif
 
-      #if ENABLED(CNC_WORKSPACE_PLANES)
-        case 17: G17(); break;                                    // G17: Select Plane XY
-        case 18: G18(); break;                                    // G18: Select Plane ZX
-        case 19: G19(); break;                                    // G19: Select Plane YZ
-      #endif
+    #if ENABLED(NOZZLE_CLEAN_FEATURE)
+      _G(12, G12),                                                // G12: Nozzle Clean
+    #endif
 
-      #if ENABLED(INCH_MODE_SUPPORT)
-        case 20: G20(); break;                                    // G20: Inch Mode
-        case 21: G21(); break;                                    // G21: MM Mode
-      #else
-        case 21: NOOP; break;                                     // No error on unknown G21
-      #endif
+    #if ENABLED(CNC_WORKSPACE_PLANES)
+      _G(17, G17),                                                // G17: Select Plane XY
+      _G(18, G18),                                                // G18: Select Plane ZX
+      _G(19, G19),                                                // G19: Select Plane YZ
+    #endif
 
-      #if ENABLED(G26_MESH_VALIDATION)
-        case 26: G26(); break;                                    // G26: Mesh Validation Pattern generation
-      #endif
+    #if ENABLED(INCH_MODE_SUPPORT)
+      _G(20, G20),                                                // G20: Inch Mode
+      _G(21, G21),                                                // G21: MM Mode
+    #else
+      _G(21, nullptr),                                            // No error on unknown G21
+    #endif
 
-      #if ENABLED(NOZZLE_PARK_FEATURE)
-        case 27: G27(); break;                                    // G27: Nozzle Park
-      #endif
+    #if ENABLED(G26_MESH_VALIDATION)
+      _G(26, G26),                                                // G26: Mesh Validation Pattern generation
+    #endif
 
-      case 28: G28(); break;                                      // G28: Home one or more axes
+    #if ENABLED(NOZZLE_PARK_FEATURE)
+      _G(27, G27),                                                // G27: Nozzle Park
+    #endif
 
-      #if HAS_LEVELING
-        case 29:                                                  // G29: Bed leveling calibration
-          #if ENABLED(G29_RETRY_AND_RECOVER)
-            G29_with_retry();
-          #else
-            G29();
-          #endif
-          break;
-      #endif // HAS_LEVELING
+    _G(28, G28),                                                  // G28: Home one or more axes
 
-      #if HAS_BED_PROBE
-        case 30: G30(); break;                                    // G30: Single Z probe
-        #if ENABLED(Z_PROBE_SLED)
-          case 31: G31(); break;                                  // G31: dock the sled
-          case 32: G32(); break;                                  // G32: undock the sled
-        #endif
-      #endif
+    #if HAS_LEVELING
+      _G(29, TERN(G29_RETRY_AND_RECOVER, G29_with_retry, G29)),   // G29: Bed leveling calibration
+    #endif
 
-      #if ENABLED(DELTA_AUTO_CALIBRATION)
-        case 33: G33(); break;                                    // G33: Delta Auto-Calibration
+    #if HAS_BED_PROBE
+      _G(30, G30),                                                // G30: Single Z probe
+      #if ENABLED(Z_PROBE_SLED)
+        _G(31, G31),                                              // G31: dock the sled
+        _G(32, G32),                                              // G32: undock the sled
       #endif
+    #endif
 
-      #if ENABLED(Z_STEPPER_AUTO_ALIGN)
-        case 34: G34(); break;                                    // G34: Z Stepper automatic alignment using probe
-      #endif
+    #if ENABLED(DELTA_AUTO_CALIBRATION)
+      _G(33, G33),                                                // G33: Delta Auto-Calibration
+    #endif
 
-      #if ENABLED(ASSISTED_TRAMMING)
-        case 35: G35(); break;                                    // G35: Read four bed corners to help adjust bed screws
-      #endif
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      _G(34, G34),                                                // G34: Z Stepper automatic alignment using probe
+    #endif
 
-      #if ENABLED(G38_PROBE_TARGET)
-        case 38:                                                  // G38.2, G38.3: Probe towards target
-          if (WITHIN(parser.subcode, 2, TERN(G38_PROBE_AWAY, 5, 3)))
-            G38(parser.subcode);                                  // G38.4, G38.5: Probe away from target
-          break;
-      #endif
+    #if ENABLED(ASSISTED_TRAMMING)
+      _G(35, G35),                                                // G35: Read four bed corners to help adjust bed screws
+    #endif
 
-      #if ENABLED(CNC_COORDINATE_SYSTEMS)
-        case 53: G53(); break;                                    // G53: (prefix) Apply native workspace
-        case 54: G54(); break;                                    // G54: Switch to Workspace 1
-        case 55: G55(); break;                                    // G55: Switch to Workspace 2
-        case 56: G56(); break;                                    // G56: Switch to Workspace 3
-        case 57: G57(); break;                                    // G57: Switch to Workspace 4
-        case 58: G58(); break;                                    // G58: Switch to Workspace 5
-        case 59: G59(); break;                                    // G59.0 - G59.3: Switch to Workspace 6-9
+    #if ENABLED(G38_PROBE_TARGET)
+      _GS(38, 2, G38),                                            // G38.2, G38.3: Probe towards target
+      _GS(38, 3, G38),
+      #if ENABLED(G38_PROBE_AWAY)
+        _GS(38, 4, G38),                                          // G38.4, G38.5: Probe away from target
+        _GS(38, 5, G38),
       #endif
+    #endif
 
-      #if SAVED_POSITIONS
-        case 60: G60(); break;                                    // G60:  save current position
-        case 61: G61(); break;                                    // G61:  Apply/restore saved coordinates.
-      #endif
+    #if HAS_MESH
+      _G(42, G42),                                                // G42: Coordinated move to a mesh point
+    #endif
 
-      #if ENABLED(PROBE_TEMP_COMPENSATION)
-        case 76: G76(); break;                                    // G76: Calibrate first layer compensation values
-      #endif
+    #if ENABLED(CNC_COORDINATE_SYSTEMS)
+      _G(53, G53),                                                // G53: (prefix) Apply native workspace
+      _G(54, G54),                                                // G54: Switch to Workspace 1
+      _G(55, G55),                                                // G55: Switch to Workspace 2
+      _G(56, G56),                                                // G56: Switch to Workspace 3
+      _G(57, G57),                                                // G57: Switch to Workspace 4
+      _G(58, G58),                                                // G58: Switch to Workspace 5
+      _G(59, G59),                                                // G59.0 - G59.3: Switch to Workspace 6-9
+    #endif
 
-      #if ENABLED(GCODE_MOTION_MODES)
-        case 80: G80(); break;                                    // G80: Reset the current motion mode
-      #endif
+    #if SAVED_POSITIONS
+      _G(60, G60),                                                // G60:  save current position
+      _G(61, G61),                                                // G61:  Apply/restore saved coordinates.
+    #endif
 
-      case 90: set_relative_mode(false); break;                   // G90: Absolute Mode
-      case 91: set_relative_mode(true);  break;                   // G91: Relative Mode
+    #if ENABLED(PROBE_TEMP_COMPENSATION)
+      _G(76, G76),                                                // G76: Calibrate first layer compensation values
+    #endif
 
-      case 92: G92(); break;                                      // G92: Set current axis position(s)
+    #if ENABLED(GCODE_MOTION_MODES)
+      _G(80, G80),                                                // G80: Reset the current motion mode
+    #endif
 
-      #if HAS_MESH
-        case 42: G42(); break;                                    // G42: Coordinated move to a mesh point
-      #endif
+    _G(90, G90),                                                  // G90: Absolute Mode
+    _G(91, G91),                                                  // G91: Relative Mode
 
-      #if ENABLED(CALIBRATION_GCODE)
-        case 425: G425(); break;                                  // G425: Perform calibration with calibration cube
-      #endif
+    _G(92, G92),                                                  // G92: Set current axis position(s)
 
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        case 800: parser.debug(); break;                          // G800: GCode Parser Test for G
-      #endif
+    #if ENABLED(CALIBRATION_GCODE)
+      _G(425, G425),                                              // G425: Perform calibration with calibration cube
+    #endif
 
-      default: parser.unknown_command_warning(); break;
-    }
-    break;
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      _G(800, GCodeParser::debug),                                // G800: GCode Parser Test for G
+    #endif
 
-    case 'M': switch (parser.codenum) {
+    #if HAS_RESUME_CONTINUE
+      _M(0, M0_M1),                                               // M0: Unconditional stop - Wait for user button press on LCD
+      _M(1, M0_M1),                                               // M1: Conditional stop - Wait for user button press on LCD
+    #endif
 
-      #if HAS_RESUME_CONTINUE
-        case 0:                                                   // M0: Unconditional stop - Wait for user button press on LCD
-        case 1: M0_M1(); break;                                   // M1: Conditional stop - Wait for user button press on LCD
-      #endif
+    #if HAS_CUTTER
+      _M(3, M3),                                                  // M3: Turn ON Laser | Spindle (clockwise), set Power | Speed
+      _M(4, M4),                                                  // M4: Turn ON Laser | Spindle (counter-clockwise), set Power | Speed
+      _M(5, M5),                                                  // M5: Turn OFF Laser | Spindle
+    #endif
 
-      #if HAS_CUTTER
-        case 3: M3_M4(false); break;                              // M3: Turn ON Laser | Spindle (clockwise), set Power | Speed
-        case 4: M3_M4(true ); break;                              // M4: Turn ON Laser | Spindle (counter-clockwise), set Power | Speed
-        case 5: M5(); break;                                      // M5: Turn OFF Laser | Spindle
+    #if ENABLED(COOLANT_CONTROL)
+      #if ENABLED(COOLANT_MIST)
+        _M(7, M7),                                                // M7: Mist coolant ON
       #endif
-
-      #if ENABLED(COOLANT_CONTROL)
-        #if ENABLED(COOLANT_MIST)
-          case 7: M7(); break;                                    // M7: Mist coolant ON
-        #endif
-        #if ENABLED(COOLANT_FLOOD)
-          case 8: M8(); break;                                    // M8: Flood coolant ON
-        #endif
-        case 9: M9(); break;                                      // M9: Coolant OFF
+      #if ENABLED(COOLANT_FLOOD)
+        _M(8, M8),                                                // M8: Flood coolant ON
       #endif
+      _M(9, M9),                                                  // M9: Coolant OFF
+    #endif
 
-      #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
-        case 12: M12(); break;                                    // M12: Synchronize and optionally force a CLC set
-      #endif
+    #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
+      _M(12, M12),                                                // M12: Synchronize and optionally force a CLC set
+    #endif
+
+    #if ENABLED(EXPECTED_PRINTER_CHECK)
+      _M(16, M16),                                                // M16: Expected printer check
+    #endif
+
+    _M(17, M17),                                                  // M17: Enable all stepper motors
+    _M(18, M18_M84),                                              // M18: Disable Steppers / Set Timeout
+
+    #if ENABLED(SDSUPPORT)
+      _M(20, M20),                                                // M20: List SD card
+      _M(21, M21),                                                // M21: Init SD card
+      _M(22, M22),                                                // M22: Release SD card
+      _M(23, M23),                                                // M23: Select file
+      _M(24, M24),                                                // M24: Start SD print
+      _M(25, M25),                                                // M25: Pause SD print
+      _M(26, M26),                                                // M26: Set SD index
+      _M(27, M27),                                                // M27: Get SD status
+      _M(28, M28),                                                // M28: Start SD write
+      _M(29, M29),                                                // M29: Stop SD write
+      _M(30, M30),                                                // M30 <filename> Delete File
+    #endif
 
-      #if ENABLED(EXPECTED_PRINTER_CHECK)
-        case 16: M16(); break;                                    // M16: Expected printer check
+    _M(31, M31),                                                  // M31: Report time since the start of SD print or last M109
+
+    #if ENABLED(SDSUPPORT)
+      _M(32, M32),                                                // M32: Select file and start SD print
+      #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
+        _M(33, M33),                                              // M33: Get the long full path to a file or folder
+      #endif
+      #if BOTH(SDCARD_SORT_ALPHA, SDSORT_GCODE)
+        _M(34, M34),                                              // M34: Set SD card sorting options
       #endif
+    #endif
 
-      case 17: M17(); break;                                      // M17: Enable all stepper motors
-
-      #if ENABLED(SDSUPPORT)
-        case 20: M20(); break;                                    // M20: List SD card
-        case 21: M21(); break;                                    // M21: Init SD card
-        case 22: M22(); break;                                    // M22: Release SD card
-        case 23: M23(); break;                                    // M23: Select file
-        case 24: M24(); break;                                    // M24: Start SD print
-        case 25: M25(); break;                                    // M25: Pause SD print
-        case 26: M26(); break;                                    // M26: Set SD index
-        case 27: M27(); break;                                    // M27: Get SD status
-        case 28: M28(); break;                                    // M28: Start SD write
-        case 29: M29(); break;                                    // M29: Stop SD write
-        case 30: M30(); break;                                    // M30 <filename> Delete File
-        case 32: M32(); break;                                    // M32: Select file and start SD print
-
-        #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
-          case 33: M33(); break;                                  // M33: Get the long full path to a file or folder
-        #endif
+    _M(42, M42),                                                  // M42: Change pin state
 
-        #if BOTH(SDCARD_SORT_ALPHA, SDSORT_GCODE)
-          case 34: M34(); break;                                  // M34: Set SD card sorting options
-        #endif
+    #if ENABLED(PINS_DEBUGGING)
+      _M(43, M43),                                                // M43: Read pin state
+    #endif
 
-        case 928: M928(); break;                                  // M928: Start SD write
-      #endif // SDSUPPORT
+    #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+      _M(48, M48),                                                // M48: Z probe repeatability test
+    #endif
 
-      case 31: M31(); break;                                      // M31: Report time since the start of SD print or last M109
-      case 42: M42(); break;                                      // M42: Change pin state
+    #if ENABLED(LCD_SET_PROGRESS_MANUALLY)
+      _M(73, M73),                                                // M73: Set progress percentage (for display on LCD)
+    #endif
 
-      #if ENABLED(PINS_DEBUGGING)
-        case 43: M43(); break;                                    // M43: Read pin state
-      #endif
+    _M(75, M75),                                                  // M75: Start print timer
+    _M(76, M76),                                                  // M76: Pause print timer
+    _M(77, M77),                                                  // M77: Stop print timer
 
-      #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
-        case 48: M48(); break;                                    // M48: Z probe repeatability test
-      #endif
+    #if ENABLED(PRINTCOUNTER)
+      _M(78, M78),                                                // M78: Show print statistics
+    #endif
 
-      #if ENABLED(LCD_SET_PROGRESS_MANUALLY)
-        case 73: M73(); break;                                    // M73: Set progress percentage (for display on LCD)
-      #endif
+    #if ENABLED(PSU_CONTROL)
+      _M(80, M80),                                                // M80: Turn on Power Supply
+    #endif
+    _M(81, M81),                                                  // M81: Turn off Power, including Power Supply, if possible
 
-      case 75: M75(); break;                                      // M75: Start print timer
-      case 76: M76(); break;                                      // M76: Pause print timer
-      case 77: M77(); break;                                      // M77: Stop print timer
+    _M(82, M82),                                                  // M82: Set E axis normal mode (same as other axes)
+    _M(83, M83),                                                  // M83: Set E axis relative mode
+    _M(84, M18_M84),                                              // M84: Disable Steppers / Set Timeout
+    _M(85, M85),                                                  // M85: Set inactivity stepper shutdown timeout
+    _M(92, M92),                                                  // M92: Set the steps-per-unit for one or more axes
 
-      #if ENABLED(PRINTCOUNTER)
-        case 78: M78(); break;                                    // M78: Show print statistics
-      #endif
+    #if ENABLED(M100_FREE_MEMORY_WATCHER)
+      _M(100, M100),                                              // M100: Free Memory Report
+    #endif
 
-      #if ENABLED(M100_FREE_MEMORY_WATCHER)
-        case 100: M100(); break;                                  // M100: Free Memory Report
-      #endif
+    #if ENABLED(GCODE_PROFILER)
+      _M(101, M101),                                              // M101: G-code dispatch statistics
+    #endif
 
-      #if EXTRUDERS
-        case 104: M104(); break;                                  // M104: Set hot end temperature
-        case 109: M109(); break;                                  // M109: Wait for hotend temperature to reach target
-      #endif
+    #if EXTRUDERS
+      _M(104, M104),                                              // M104: Set hot end temperature
+    #endif
 
-      case 105: M105(); return;                                   // M105: Report Temperatures (and say "ok")
+    _M(105, M105),                                                // M105: Report Temperatures (and say "ok")
 
-      #if HAS_FAN
-        case 106: M106(); break;                                  // M106: Fan On
-        case 107: M107(); break;                                  // M107: Fan Off
-      #endif
+    #if HAS_FAN
+      _M(106, M106),                                              // M106: Fan On
+      _M(107, M107),                                              // M107: Fan Off
+    #endif
 
-      case 110: M110(); break;                                    // M110: Set Current Line Number
-      case 111: M111(); break;                                    // M111: Set debug level
-
-      #if DISABLED(EMERGENCY_PARSER)
-        case 108: M108(); break;                                  // M108: Cancel Waiting
-        case 112: M112(); break;                                  // M112: Full Shutdown
-        case 410: M410(); break;                                  // M410: Quickstop - Abort all the planned moves.
-        TERN_(HOST_PROMPT_SUPPORT, case 876:)                     // M876: Handle Host prompt responses
-      #else
-        case 108: case 112: case 410:
-        TERN_(HOST_PROMPT_SUPPORT, case 876:)
-        break;
-      #endif
+    _M(108, TERN(EMERGENCY_PARSER, nullptr, M108)),               // M108: Cancel Waiting
 
-      #if ENABLED(HOST_KEEPALIVE_FEATURE)
-        case 113: M113(); break;                                  // M113: Set Host Keepalive interval
-      #endif
+    #if EXTRUDERS
+      _M(109, M109),                                              // M109: Wait for hotend temperature to reach target
+    #endif
 
-      #if HAS_HEATED_BED
-        case 140: M140(); break;                                  // M140: Set bed temperature
-        case 190: M190(); break;                                  // M190: Wait for bed temperature to reach target
-      #endif
+    _M(110, M110),                                                // M110: Set Current Line Number
+    _M(111, M111),                                                // M111: Set debug level
+    _M(112, TERN(EMERGENCY_PARSER, nullptr, M112)),               // M112: Full Shutdown
 
-      #if HAS_HEATED_CHAMBER
-        case 141: M141(); break;                                  // M141: Set chamber temperature
-        case 191: M191(); break;                                  // M191: Wait for chamber temperature to reach target
-      #endif
+    #if ENABLED(HOST_KEEPALIVE_FEATURE)
+      _M(113, M113),                                              // M113: Set Host Keepalive interval
+    #endif
 
-      #if BOTH(AUTO_REPORT_TEMPERATURES, HAS_TEMP_SENSOR)
-        case 155: M155(); break;                                  // M155: Set temperature auto-report interval
+    _M(114, M114),                                                // M114: Report current position
+    _M(115, M115),                                                // M115: Report capabilities
+    _M(117, M117),                                                // M117: Set LCD message text, if possible
+    _M(118, M118),                                                // M118: Display a message in the host console
+    _M(119, M119),                                                // M119: Report endstop states
+    _M(120, M120),                                                // M120: Enable endstops
+    _M(121, M121),                                                // M121: Disable endstops
+
+    #if HAS_TRINAMIC_CONFIG || HAS_L64XX
+      _M(122, M122),                                              // M122: Report driver configuration and status
+    #endif
+
+    #if ENABLED(STEPPER_ISR_PROFILER)
+      _M(124, M124),                                              // M124: Stepper ISR cycle profile
+    #endif
+
+    #if ENABLED(PARK_HEAD_ON_PAUSE)
+      _M(125, M125),                                              // M125: Store current position and move to filament change position
+    #endif
+
+    #if ENABLED(BARICUDA)
+      // PWM for HEATER_1_PIN
+      #if HAS_HEATER_1
+        _M(126, M126),                                            // M126: valve open
+        _M(127, M127),                                            // M127: valve closed
       #endif
 
-      #if ENABLED(PARK_HEAD_ON_PAUSE)
-        case 125: M125(); break;                                  // M125: Store current position and move to filament change position
+      // PWM for HEATER_2_PIN
+      #if HAS_HEATER_2
+        _M(128, M128),                                            // M128: valve open
+        _M(129, M129),                                            // M129: valve closed
       #endif
+    #endif // BARICUDA
 
-      #if ENABLED(BARICUDA)
-        // PWM for HEATER_1_PIN
-        #if HAS_HEATER_1
-          case 126: M126(); break;                                // M126: valve open
-          case 127: M127(); break;                                // M127: valve closed
-        #endif
+    #if HAS_HEATED_BED
+      _M(140, M140),                                              // M140: Set bed temperature
+    #endif
 
-        // PWM for HEATER_2_PIN
-        #if HAS_HEATER_2
-          case 128: M128(); break;                                // M128: valve open
-          case 129: M129(); break;                                // M129: valve closed
-        #endif
-      #endif // BARICUDA
+    #if HAS_HEATED_CHAMBER
+      _M(141, M141),                                              // M141: Set chamber temperature
+    #endif
 
-      #if ENABLED(PSU_CONTROL)
-        case 80: M80(); break;                                    // M80: Turn on Power Supply
+    #if PREHEAT_COUNT
+      _M(145, M145),                                              // M145: Set material heatup parameters
+    #endif
+
+    #if ENABLED(TEMPERATURE_UNITS_SUPPORT)
+      _M(149, M149),                                              // M149: Set temperature units
+    #endif
+
+    #if HAS_COLOR_LEDS
+      _M(150, M150),                                              // M150: Set Status LED Color
+    #endif
+
+    #if BOTH(AUTO_REPORT_TEMPERATURES, HAS_TEMP_SENSOR)
+      _M(155, M155),                                              // M155: Set temperature auto-report interval
+    #endif
+
+    #if ENABLED(MIXING_EXTRUDER)
+      _M(163, M163),                                              // M163: Set a component weight for mixing extruder
+      _M(164, M164),                                              // M164: Save current mix as a virtual extruder
+      #if ENABLED(DIRECT_MIXING_IN_G1)
+        _M(165, M165),                                            // M165: Set multiple mix weights
       #endif
-      case 81: M81(); break;                                      // M81: Turn off Power, including Power Supply, if possible
-
-      case 82: M82(); break;                                      // M82: Set E axis normal mode (same as other axes)
-      case 83: M83(); break;                                      // M83: Set E axis relative mode
-      case 18: case 84: M18_M84(); break;                         // M18/M84: Disable Steppers / Set Timeout
-      case 85: M85(); break;                                      // M85: Set inactivity stepper shutdown timeout
-      case 92: M92(); break;                                      // M92: Set the steps-per-unit for one or more axes
-      case 114: M114(); break;                                    // M114: Report current position
-      case 115: M115(); break;                                    // M115: Report capabilities
-      case 117: M117(); break;                                    // M117: Set LCD message text, if possible
-      case 118: M118(); break;                                    // M118: Display a message in the host console
-      case 119: M119(); break;                                    // M119: Report endstop states
-      case 120: M120(); break;                                    // M120: Enable endstops
-      case 121: M121(); break;                                    // M121: Disable endstops
-
-      #if PREHEAT_COUNT
-        case 145: M145(); break;                                  // M145: Set material heatup parameters
+      #if ENABLED(GRADIENT_MIX)
+        _M(166, M166),                                            // M166: Set Gradient Mix
       #endif
+    #endif
 
-      #if ENABLED(TEMPERATURE_UNITS_SUPPORT)
-        case 149: M149(); break;                                  // M149: Set temperature units
-      #endif
+    #if HAS_HEATED_BED
+      _M(190, M190),                                              // M190: Wait for bed temperature to reach target
+    #endif
 
-      #if HAS_COLOR_LEDS
-        case 150: M150(); break;                                  // M150: Set Status LED Color
-      #endif
+    #if HAS_HEATED_CHAMBER
+      _M(191, M191),                                              // M191: Wait for chamber temperature to reach target
+    #endif
 
-      #if ENABLED(MIXING_EXTRUDER)
-        case 163: M163(); break;                                  // M163: Set a component weight for mixing extruder
-        case 164: M164(); break;                                  // M164: Save current mix as a virtual extruder
-        #if ENABLED(DIRECT_MIXING_IN_G1)
-          case 165: M165(); break;                                // M165: Set multiple mix weights
-        #endif
-        #if ENABLED(GRADIENT_MIX)
-          case 166: M166(); break;                                // M166: Set Gradient Mix
-        #endif
-      #endif
+    #if DISABLED(NO_VOLUMETRICS)
+      _M(200, M200),                                              // M200: Set filament diameter, E to cubic units
+    #endif
 
-      #if DISABLED(NO_VOLUMETRICS)
-        case 200: M200(); break;                                  // M200: Set filament diameter, E to cubic units
-      #endif
+    _M(201, M201),                                                // M201: Set max acceleration for print moves (units/s^2)
 
-      case 201: M201(); break;                                    // M201: Set max acceleration for print moves (units/s^2)
+    #if 0
+      _M(202, M202),                                              // M202: Not used for Sprinter/grbl gen6
+    #endif
 
-      #if 0
-        case 202: M202(); break;                                  // M202: Not used for Sprinter/grbl gen6
-      #endif
+    _M(203, M203),                                                // M203: Set max feedrate (units/sec)
+    _M(204, M204),                                                // M204: Set acceleration
+    _M(205, M205),                                                // M205: Set advanced settings
 
-      case 203: M203(); break;                                    // M203: Set max feedrate (units/sec)
-      case 204: M204(); break;                                    // M204: Set acceleration
-      case 205: M205(); break;                                    // M205: Set advanced settings
+    #if HAS_M206_COMMAND
+      _M(206, M206),                                              // M206: Set home offsets
+    #endif
 
-      #if HAS_M206_COMMAND
-        case 206: M206(); break;                                  // M206: Set home offsets
+    #if ENABLED(FWRETRACT)
+      _M(207, M207),                                              // M207: Set Retract Length, Feedrate, and Z lift
+      _M(208, M208),                                              // M208: Set Recover (unretract) Additional Length and Feedrate
+      #if ENABLED(FWRETRACT_AUTORETRACT)
+        _M(209, MIN_AUTORETRACT <= MAX_AUTORETRACT ? M209 : nullptr), // M209: Turn Automatic Retract Detection on/off
       #endif
+    #endif
 
-      #if ENABLED(FWRETRACT)
-        case 207: M207(); break;                                  // M207: Set Retract Length, Feedrate, and Z lift
-        case 208: M208(); break;                                  // M208: Set Recover (unretract) Additional Length and Feedrate
-        #if ENABLED(FWRETRACT_AUTORETRACT)
-          case 209:
-            if (MIN_AUTORETRACT <= MAX_AUTORETRACT) M209();       // M209: Turn Automatic Retract Detection on/off
-            break;
-        #endif
-      #endif
+    #if HAS_SOFTWARE_ENDSTOPS
+      _M(211, M211),                                              // M211: Enable, Disable, and/or Report software endstops
+    #endif
 
-      #if HAS_SOFTWARE_ENDSTOPS
-        case 211: M211(); break;                                  // M211: Enable, Disable, and/or Report software endstops
-      #endif
+    #if EXTRUDERS > 1
+      _M(217, M217),                                              // M217: Set filament swap parameters
+    #endif
 
-      #if EXTRUDERS > 1
-        case 217: M217(); break;                                  // M217: Set filament swap parameters
-      #endif
+    #if HAS_HOTEND_OFFSET
+      _M(218, M218),                                              // M218: Set a tool offset
+    #endif
 
-      #if HAS_HOTEND_OFFSET
-        case 218: M218(); break;                                  // M218: Set a tool offset
-      #endif
+    _M(220, M220),                                                // M220: Set Feedrate Percentage: S<percent> ("FR" on your LCD)
 
-      case 220: M220(); break;                                    // M220: Set Feedrate Percentage: S<percent> ("FR" on your LCD)
+    #if EXTRUDERS
+      _M(221, M221),                                              // M221: Set Flow Percentage
+    #endif
 
-      #if EXTRUDERS
-        case 221: M221(); break;                                  // M221: Set Flow Percentage
-      #endif
+    _M(226, M226),                                                // M226: Wait until a pin reaches a state
 
-      case 226: M226(); break;                                    // M226: Wait until a pin reaches a state
+    #if ENABLED(SEGMENT_COALESCING)
+      _M(230, M230),                                              // M230: Segment coalescing
+    #endif
 
-      #if HAS_SERVOS
-        case 280: M280(); break;                                  // M280: Set servo position absolute
-        #if ENABLED(EDITABLE_SERVO_ANGLES)
-          case 281: M281(); break;                                // M281: Set servo angles
-        #endif
-      #endif
+    #if ENABLED(PHOTO_GCODE)
+      _M(240, M240),                                              // M240: Trigger a camera
+    #endif
 
-      #if ENABLED(BABYSTEPPING)
-        case 290: M290(); break;                                  // M290: Babystepping
-      #endif
+    #if HAS_LCD_CONTRAST
+      _M(250, M250),                                              // M250: Set LCD contrast
+    #endif
 
-      #if HAS_BUZZER
-        case 300: M300(); break;                                  // M300: Play beep tone
-      #endif
+    #if ENABLED(EXPERIMENTAL_I2CBUS)
+      _M(260, M260),                                              // M260: Send data to an i2c slave
+      _M(261, M261),                                              // M261: Request data from an i2c slave
+    #endif
 
-      #if ENABLED(PIDTEMP)
-        case 301: M301(); break;                                  // M301: Set hotend PID parameters
+    #if HAS_SERVOS
+      _M(280, M280),                                              // M280: Set servo position absolute
+      #if ENABLED(EDITABLE_SERVO_ANGLES)
+        _M(281, M281),                                            // M281: Set servo angles
       #endif
+    #endif
 
-      #if ENABLED(PIDTEMPBED)
-        case 304: M304(); break;                                  // M304: Set bed PID parameters
-      #endif
+    #if ENABLED(BABYSTEPPING)
+      _M(290, M290),                                              // M290: Babystepping
+    #endif
 
-      #if ENABLED(PHOTO_GCODE)
-        case 240: M240(); break;                                  // M240: Trigger a camera
-      #endif
+    #if HAS_BUZZER
+      _M(300, M300),                                              // M300: Play beep tone
+    #endif
 
-      #if HAS_LCD_CONTRAST
-        case 250: M250(); break;                                  // M250: Set LCD contrast
-      #endif
+    #if ENABLED(PIDTEMP)
+      _M(301, M301),                                              // M301: Set hotend PID parameters
+    #endif
 
-      #if ENABLED(EXPERIMENTAL_I2CBUS)
-        case 260: M260(); break;                                  // M260: Send data to an i2c slave
-        case 261: M261(); break;                                  // M261: Request data from an i2c slave
-      #endif
+    #if ENABLED(PREVENT_COLD_EXTRUSION)
+      _M(302, M302),                                              // M302: Allow cold extrudes (set the minimum extrude temperature)
+    #endif
 
-      #if ENABLED(PREVENT_COLD_EXTRUSION)
-        case 302: M302(); break;                                  // M302: Allow cold extrudes (set the minimum extrude temperature)
-      #endif
+    #if HAS_PID_HEATING
+      _M(303, M303),                                              // M303: PID autotune
+    #endif
 
-      #if HAS_PID_HEATING
-        case 303: M303(); break;                                  // M303: PID autotune
-      #endif
+    #if ENABLED(PIDTEMPBED)
+      _M(304, M304),                                              // M304: Set bed PID parameters
+    #endif
 
-      #if HAS_USER_THERMISTORS
-        case 305: M305(); break;                                  // M305: Set user thermistor parameters
-      #endif
+    #if HAS_USER_THERMISTORS
+      _M(305, M305),                                              // M305: Set user thermistor parameters
+    #endif
 
-      #if ENABLED(REPETIER_GCODE_M360)
-        case 360: M360(); break;                                  // M360: Firmware settings
-      #endif
+    #if HAS_MICROSTEPS
+      _M(350, M350),                                              // M350: Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
+      _M(351, M351),                                              // M351: Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+    #endif
 
-      #if ENABLED(MORGAN_SCARA)
-        case 360: if (M360()) return; break;                      // M360: SCARA Theta pos1
-        case 361: if (M361()) return; break;                      // M361: SCARA Theta pos2
-        case 362: if (M362()) return; break;                      // M362: SCARA Psi pos1
-        case 363: if (M363()) return; break;                      // M363: SCARA Psi pos2
-        case 364: if (M364()) return; break;                      // M364: SCARA Psi pos3 (90 deg to Theta)
-      #endif
+    #if ENABLED(CASE_LIGHT_ENABLE)
+      _M(355, M355),                                              // M355: Set case light brightness
+    #endif
 
-      #if EITHER(EXT_SOLENOID, MANUAL_SOLENOID_CONTROL)
-        case 380: M380(); break;                                  // M380: Activate solenoid on active (or specified) extruder
-        case 381: M381(); break;                                  // M381: Disable all solenoids or, if MANUAL_SOLENOID_CONTROL, active (or specified) solenoid
-      #endif
+    #if ENABLED(REPETIER_GCODE_M360)
+      _M(360, M360),                                              // M360: Firmware settings
+    #endif
 
-      case 400: M400(); break;                                    // M400: Finish all moves
+    #if ENABLED(MORGAN_SCARA)
+      _M(360, M360),                                              // M360: SCARA Theta pos1
+      _M(361, M361),                                              // M361: SCARA Theta pos2
+      _M(362, M362),                                              // M362: SCARA Psi pos1
+      _M(363, M363),                                              // M363: SCARA Psi pos2
+      _M(364, M364),                                              // M364: SCARA Psi pos3 (90 deg to Theta)
+    #endif
 
-      #if HAS_BED_PROBE
-        case 401: M401(); break;                                  // M401: Deploy probe
-        case 402: M402(); break;                                  // M402: Stow probe
-      #endif
+    #if EITHER(EXT_SOLENOID, MANUAL_SOLENOID_CONTROL)
+      _M(380, M380),                                              // M380: Activate solenoid on active (or specified) extruder
+      _M(381, M381),                                              // M381: Disable all solenoids or, if MANUAL_SOLENOID_CONTROL, active (or specified) solenoid
+    #endif
 
-      #if ENABLED(PRUSA_MMU2)
-        case 403: M403(); break;
-      #endif
+    _M(400, M400),                                                // M400: Finish all moves
 
-      #if ENABLED(FILAMENT_WIDTH_SENSOR)
-        case 404: M404(); break;                                  // M404: Enter the nominal filament width (3mm, 1.75mm ) N<3.0> or display nominal filament width
-        case 405: M405(); break;                                  // M405: Turn on filament sensor for control
-        case 406: M406(); break;                                  // M406: Turn off filament sensor for control
-        case 407: M407(); break;                                  // M407: Display measured filament diameter
-      #endif
+    #if HAS_BED_PROBE
+      _M(401, M401),                                              // M401: Deploy probe
+      _M(402, M402),                                              // M402: Stow probe
+    #endif
 
-      #if HAS_FILAMENT_SENSOR
-        case 412: M412(); break;                                  // M412: Enable/Disable filament runout detection
-      #endif
+    #if ENABLED(PRUSA_MMU2)
+      _M(403, M403),
+    #endif
 
-      #if HAS_LEVELING
-        case 420: M420(); break;                                  // M420: Enable/Disable Bed Leveling
-      #endif
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      _M(404, M404),                                              // M404: Enter the nominal filament width (3mm, 1.75mm ) N<3.0> or display nominal filament width
+      _M(405, M405),                                              // M405: Turn on filament sensor for control
+      _M(406, M406),                                              // M406: Turn off filament sensor for control
+      _M(407, M407),                                              // M407: Display measured filament diameter
+    #endif
 
-      #if HAS_MESH
-        case 421: M421(); break;                                  // M421: Set a Mesh Bed Leveling Z coordinate
-      #endif
+    _M(410, TERN(EMERGENCY_PARSER, nullptr, M410)),               // M410: Quickstop - Abort all the planned moves.
 
-      #if ENABLED(BACKLASH_GCODE)
-        case 425: M425(); break;                                  // M425: Tune backlash compensation
-      #endif
+    #if HAS_FILAMENT_SENSOR
+      _M(412, M412),                                              // M412: Enable/Disable filament runout detection
+    #endif
 
-      #if HAS_M206_COMMAND
-        case 428: M428(); break;                                  // M428: Apply current_position to home_offset
-      #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      _M(413, M413),                                              // M413: Enable/disable/query Power-Loss Recovery
+    #endif
 
-      #if HAS_POWER_MONITOR
-        case 430: M430(); break;                                  // M430: Read the system current (A), voltage (V), and power (W)
-      #endif
+    #if HAS_LEVELING
+      _M(420, M420),                                              // M420: Enable/Disable Bed Leveling
+    #endif
 
-      #if ENABLED(CANCEL_OBJECTS)
-        case 486: M486(); break;                                  // M486: Identify and cancel objects
-      #endif
+    #if HAS_MESH
+      _M(421, M421),                                              // M421: Set a Mesh Bed Leveling Z coordinate
+    #endif
 
-      case 500: M500(); break;                                    // M500: Store settings in EEPROM
-      case 501: M501(); break;                                    // M501: Read settings from EEPROM
-      case 502: M502(); break;                                    // M502: Revert to default settings
-      #if DISABLED(DISABLE_M503)
-        case 503: M503(); break;                                  // M503: print settings currently in memory
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      _M(422, M422),                                              // M422: Set Z Stepper automatic alignment position using probe
+    #endif
+
+    #if ENABLED(BACKLASH_GCODE)
+      _M(425, M425),                                              // M425: Tune backlash compensation
+    #endif
+
+    #if HAS_M206_COMMAND
+      _M(428, M428),                                              // M428: Apply current_position to home_offset
+    #endif
+
+    #if HAS_POWER_MONITOR
+      _M(430, M430),                                              // M430: Read the system current (A), voltage (V), and power (W)
+    #endif
+
+    #if ENABLED(CANCEL_OBJECTS)
+      _M(486, M486),                                              // M486: Identify and cancel objects
+    #endif
+
+    _M(500, M500),                                                // M500: Store settings in EEPROM
+    _M(501, M501),                                                // M501: Read settings from EEPROM
+    _M(502, M502),                                                // M502: Revert to default settings
+    #if DISABLED(DISABLE_M503)
+      _M(503, M503),                                              // M503: print settings currently in memory
+    #endif
+    #if ENABLED(EEPROM_SETTINGS)
+      _M(504, M504),                                              // M504: Validate EEPROM contents
+    #endif
+
+    #if ENABLED(PASSWORD_FEATURE)
+      _M(510, M510),                                              // M510: Lock Printer
+      #if ENABLED(PASSWORD_UNLOCK_GCODE)
+        _M(511, M511),                                            // M511: Unlock Printer
       #endif
-      #if ENABLED(EEPROM_SETTINGS)
-        case 504: M504(); break;                                  // M504: Validate EEPROM contents
+      #if ENABLED(PASSWORD_CHANGE_GCODE)
+        _M(512, M512),                                            // M512: Set/Change/Remove Password
       #endif
+    #endif
 
-      #if ENABLED(PASSWORD_FEATURE)
-        case 510: M510(); break;                                  // M510: Lock Printer
-        #if ENABLED(PASSWORD_UNLOCK_GCODE)
-          case 511: M511(); break;                                // M511: Unlock Printer
-        #endif
-        #if ENABLED(PASSWORD_CHANGE_GCODE)
-          case 512: M512(); break;
-        #endif                                                    // M512: Set/Change/Remove Password
-      #endif
+    #if ENABLED(SDSUPPORT)
+      _M(524, M524),                                              // M524: Abort the current SD print job
+    #endif
 
-      #if ENABLED(SDSUPPORT)
-        case 524: M524(); break;                                  // M524: Abort the current SD print job
-      #endif
+    #if ENABLED(SD_ABORT_ON_ENDSTOP_HIT)
+      _M(540, M540),                                              // M540: Set abort on endstop hit for SD printing
+    #endif
 
-      #if ENABLED(SD_ABORT_ON_ENDSTOP_HIT)
-        case 540: M540(); break;                                  // M540: Set abort on endstop hit for SD printing
-      #endif
+    #if HAS_TRINAMIC_CONFIG && HAS_STEALTHCHOP
+      _M(569, M569),                                              // M569: Enable stealthChop on an axis.
+    #endif
 
-      #if ENABLED(BAUD_RATE_GCODE)
-        case 575: M575(); break;                                  // M575: Set serial baudrate
-      #endif
+    #if ENABLED(BAUD_RATE_GCODE)
+      _M(575, M575),                                              // M575: Set serial baudrate
+    #endif
 
-      #if ENABLED(ADVANCED_PAUSE_FEATURE)
-        case 600: M600(); break;                                  // M600: Pause for Filament Change
-        case 603: M603(); break;                                  // M603: Configure Filament Change
-      #endif
+    #if ENABLED(BINARY_MOTION_PROTOCOL)
+      _M(576, M576),                                              // M576: Binary motion protocol
+    #endif
 
-      #if HAS_DUPLICATION_MODE
-        case 605: M605(); break;                                  // M605: Set Dual X Carriage movement mode
-      #endif
+    #if ENABLED(INPUT_SHAPING)
+      _M(593, M593),                                              // M593: Set input shaping
+    #endif
 
-      #if ENABLED(DELTA)
-        case 665: M665(); break;                                  // M665: Set delta configurations
-      #endif
+    #if ENABLED(ADVANCED_PAUSE_FEATURE)
+      _M(600, M600),                                              // M600: Pause for Filament Change
+      _M(603, M603),                                              // M603: Configure Filament Change
+    #endif
 
-      #if ENABLED(DELTA) || HAS_EXTRA_ENDSTOPS
-        case 666: M666(); break;                                  // M666: Set delta or multiple endstop adjustment
-      #endif
+    #if HAS_DUPLICATION_MODE
+      _M(605, M605),                                              // M605: Set Dual X Carriage movement mode
+    #endif
 
-      #if ENABLED(SMART_EFFECTOR) && PIN_EXISTS(SMART_EFFECTOR_MOD)
-        case 672: M672(); break;                                  // M672: Set/clear Duet Smart Effector sensitivity
-      #endif
+    #if ENABLED(DELTA)
+      _M(665, M665),                                              // M665: Set delta configurations
+    #endif
 
-      #if ENABLED(FILAMENT_LOAD_UNLOAD_GCODES)
-        case 701: M701(); break;                                  // M701: Load Filament
-        case 702: M702(); break;                                  // M702: Unload Filament
-      #endif
+    #if ENABLED(DELTA) || HAS_EXTRA_ENDSTOPS
+      _M(666, M666),                                              // M666: Set delta or multiple endstop adjustment
+    #endif
 
-      #if ENABLED(CONTROLLER_FAN_EDITABLE)
-        case 710: M710(); break;                                  // M710: Set Controller Fan settings
-      #endif
+    #if ENABLED(SMART_EFFECTOR) && PIN_EXISTS(SMART_EFFECTOR_MOD)
+      _M(672, M672),                                              // M672: Set/clear Duet Smart Effector sensitivity
+    #endif
 
-      #if ENABLED(GCODE_MACROS)
-        case 810: case 811: case 812: case 813: case 814:
-        case 815: case 816: case 817: case 818: case 819:
-        M810_819(); break;                                        // M810-M819: Define/execute G-code macro
-      #endif
+    #if ENABLED(FILAMENT_LOAD_UNLOAD_GCODES)
+      _M(701, M701),                                              // M701: Load Filament
+      _M(702, M702),                                              // M702: Unload Filament
+    #endif
 
-      #if HAS_BED_PROBE
-        case 851: M851(); break;                                  // M851: Set Z Probe Z Offset
-      #endif
+    #if ENABLED(CONTROLLER_FAN_EDITABLE)
+      _M(710, M710),                                              // M710: Set Controller Fan settings
+    #endif
 
-      #if ENABLED(SKEW_CORRECTION_GCODE)
-        case 852: M852(); break;                                  // M852: Set Skew factors
-      #endif
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      _M(800, GCodeParser::debug),                                // M800: GCode Parser Test for M
+    #endif
 
-      #if ENABLED(PROBE_TEMP_COMPENSATION)
-        case 871: M871(); break;                                  // M871: Print/reset/clear first layer temperature offset values
-      #endif
+    #if ENABLED(GCODE_MACROS)
+      _M(810, M810_819), _M(811, M810_819), _M(812, M810_819),    // M810-M819: Define/execute G-code macro
+      _M(813, M810_819), _M(814, M810_819), _M(815, M810_819),
+      _M(816, M810_819), _M(817, M810_819), _M(818, M810_819),
+      _M(819, M810_819),
+    #endif
 
-      #if ENABLED(LIN_ADVANCE)
-        case 900: M900(); break;                                  // M900: Set advance K factor.
-      #endif
+    #if HAS_BED_PROBE
+      _M(851, M851),                                              // M851: Set Z Probe Z Offset
+    #endif
 
-      #if ANY(HAS_DIGIPOTSS, HAS_MOTOR_CURRENT_PWM, HAS_I2C_DIGIPOT, DAC_STEPPER_CURRENT)
-        case 907: M907(); break;                                  // M907: Set digital trimpot motor current using axis codes.
-        #if EITHER(HAS_DIGIPOTSS, DAC_STEPPER_CURRENT)
-          case 908: M908(); break;                                // M908: Control digital trimpot directly.
-          #if ENABLED(DAC_STEPPER_CURRENT)
-            case 909: M909(); break;                              // M909: Print digipot/DAC current value
-            case 910: M910(); break;                              // M910: Commit digipot/DAC value to external EEPROM
-          #endif
-        #endif
-      #endif
+    #if ENABLED(SKEW_CORRECTION_GCODE)
+      _M(852, M852),                                              // M852: Set Skew factors
+    #endif
 
-      #if HAS_TRINAMIC_CONFIG
-        case 122: M122(); break;                                  // M122: Report driver configuration and status
-        case 906: M906(); break;                                  // M906: Set motor current in milliamps using axis codes X, Y, Z, E
-        #if HAS_STEALTHCHOP
-          case 569: M569(); break;                                // M569: Enable stealthChop on an axis.
-        #endif
-        #if ENABLED(MONITOR_DRIVER_STATUS)
-          case 911: M911(); break;                                // M911: Report TMC2130 prewarn triggered flags
-          case 912: M912(); break;                                // M912: Clear TMC2130 prewarn triggered flags
-        #endif
-        #if ENABLED(HYBRID_THRESHOLD)
-          case 913: M913(); break;                                // M913: Set HYBRID_THRESHOLD speed.
-        #endif
-        #if USE_SENSORLESS
-          case 914: M914(); break;                                // M914: Set StallGuard sensitivity.
+    #if ENABLED(I2C_POSITION_ENCODERS)
+      _M(860, M860),                                              // M860: Report encoder module position
+      _M(861, M861),                                              // M861: Report encoder module status
+      _M(862, M862),                                              // M862: Perform axis test
+      _M(863, M863),                                              // M863: Calibrate steps/mm
+      _M(864, M864),                                              // M864: Change module address
+      _M(865, M865),                                              // M865: Check module firmware version
+      _M(866, M866),                                              // M866: Report axis error count
+      _M(867, M867),                                              // M867: Toggle error correction
+      _M(868, M868),                                              // M868: Set error correction threshold
+      _M(869, M869),                                              // M869: Report axis error
+    #endif
+
+    #if ENABLED(PROBE_TEMP_COMPENSATION)
+      _M(871, M871),                                              // M871: Print/reset/clear first layer temperature offset values
+    #endif
+
+    #if ENABLED(HOST_PROMPT_SUPPORT)
+      _M(876, TERN(EMERGENCY_PARSER, nullptr, M876)),             // M876: Handle Host prompt responses
+    #endif
+
+    #if ENABLED(LIN_ADVANCE)
+      _M(900, M900),                                              // M900: Set advance K factor.
+    #endif
+
+    #if HAS_TRINAMIC_CONFIG || HAS_L64XX
+      _M(906, M906),                                              // M906: Set motor current in milliamps using axis codes X, Y, Z, E
+    #endif
+
+    #if ANY(HAS_DIGIPOTSS, HAS_MOTOR_CURRENT_PWM, HAS_I2C_DIGIPOT, DAC_STEPPER_CURRENT)
+      _M(907, M907),                                              // M907: Set digital trimpot motor current using axis codes.
+      #if EITHER(HAS_DIGIPOTSS, DAC_STEPPER_CURRENT)
+        _M(908, M908),                                            // M908: Control digital trimpot directly.
+        #if ENABLED(DAC_STEPPER_CURRENT)
+          _M(909, M909),                                          // M909: Print digipot/DAC current value
+          _M(910, M910),                                          // M910: Commit digipot/DAC value to external EEPROM
         #endif
       #endif
+    #endif
 
-      #if HAS_L64XX
-        case 122: M122(); break;                                   // M122: Report status
-        case 906: M906(); break;                                   // M906: Set or get motor drive level
-        case 916: M916(); break;                                   // M916: L6470 tuning: Increase drive level until thermal warning
-        case 917: M917(); break;                                   // M917: L6470 tuning: Find minimum current thresholds
-        case 918: M918(); break;                                   // M918: L6470 tuning: Increase speed until max or error
+    #if HAS_TRINAMIC_CONFIG
+      #if ENABLED(MONITOR_DRIVER_STATUS)
+        _M(911, M911),                                            // M911: Report TMC2130 prewarn triggered flags
+        _M(912, M912),                                            // M912: Clear TMC2130 prewarn triggered flags
       #endif
-
-      #if HAS_MICROSTEPS
-        case 350: M350(); break;                                  // M350: Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
-        case 351: M351(); break;                                  // M351: Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+      #if ENABLED(HYBRID_THRESHOLD)
+        _M(913, M913),                                            // M913: Set HYBRID_THRESHOLD speed.
       #endif
-
-      #if ENABLED(CASE_LIGHT_ENABLE)
-        case 355: M355(); break;                                  // M355: Set case light brightness
+      #if USE_SENSORLESS
+        _M(914, M914),                                            // M914: Set StallGuard sensitivity.
       #endif
+    #endif
 
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        case 800: parser.debug(); break;                          // M800: GCode Parser Test for M
-      #endif
+    #if HAS_L64XX
+      _M(916, M916),                                              // M916: L6470 tuning: Increase drive level until thermal warning
+      _M(917, M917),                                              // M917: L6470 tuning: Find minimum current thresholds
+      _M(918, M918),                                              // M918: L6470 tuning: Increase speed until max or error
+    #endif
 
-      #if ENABLED(I2C_POSITION_ENCODERS)
-        case 860: M860(); break;                                  // M860: Report encoder module position
-        case 861: M861(); break;                                  // M861: Report encoder module status
-        case 862: M862(); break;                                  // M862: Perform axis test
-        case 863: M863(); break;                                  // M863: Calibrate steps/mm
-        case 864: M864(); break;                                  // M864: Change module address
-        case 865: M865(); break;                                  // M865: Check module firmware version
-        case 866: M866(); break;                                  // M866: Report axis error count
-        case 867: M867(); break;                                  // M867: Toggle error correction
-        case 868: M868(); break;                                  // M868: Set error correction threshold
-        case 869: M869(); break;                                  // M869: Report axis error
-      #endif
+    #if ENABLED(SDSUPPORT)
+      _M(928, M928),                                              // M928: Start SD write
+    #endif
 
-      #if ENABLED(MAGNETIC_PARKING_EXTRUDER)
-        case 951: M951(); break;                                  // M951: Set Magnetic Parking Extruder parameters
-      #endif
+    #if ENABLED(MAGNETIC_PARKING_EXTRUDER)
+      _M(951, M951),                                              // M951: Set Magnetic Parking Extruder parameters
+    #endif
 
-      #if ENABLED(Z_STEPPER_AUTO_ALIGN)
-        case 422: M422(); break;                                  // M422: Set Z Stepper automatic alignment position using probe
-      #endif
+    #if ALL(HAS_SPI_FLASH, SDSUPPORT, MARLIN_DEV_MODE)
+      _M(993, M993),                                              // M993: Backup SPI Flash to SD
+      _M(994, M994),                                              // M994: Load a Backup from SD to SPI Flash
+    #endif
 
-      #if ALL(HAS_SPI_FLASH, SDSUPPORT, MARLIN_DEV_MODE)
-        case 993: M993(); break;                                  // M993: Backup SPI Flash to SD
-        case 994: M994(); break;                                  // M994: Load a Backup from SD to SPI Flash
-      #endif
+    #if ENABLED(TOUCH_SCREEN_CALIBRATION)
+      _M(995, M995),                                              // M995: Touch screen calibration for TFT display
+    #endif
 
-      #if ENABLED(TOUCH_SCREEN_CALIBRATION)
-        case 995: M995(); break;                                  // M995: Touch screen calibration for TFT display
-      #endif
+    #if ENABLED(PLATFORM_M997_SUPPORT)
+      _M(997, M997),                                              // M997: Perform in-application firmware update
+    #endif
 
-      #if ENABLED(PLATFORM_M997_SUPPORT)
-        case 997: M997(); break;                                  // M997: Perform in-application firmware update
-      #endif
+    _M(999, M999),                                                // M999: Restart after being Stopped
 
-      case 999: M999(); break;                                    // M999: Restart after being Stopped
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      _M(1000, M1000),                                            // M1000: [INTERNAL] Resume from power-loss
+    #endif
 
-      #if ENABLED(POWER_LOSS_RECOVERY)
-        case 413: M413(); break;                                  // M413: Enable/disable/query Power-Loss Recovery
-        case 1000: M1000(); break;                                // M1000: [INTERNAL] Resume from power-loss
-      #endif
+    #if ENABLED(SDSUPPORT)
+      _M(1001, M1001),                                            // M1001: [INTERNAL] Handle SD completion
+    #endif
 
-      #if ENABLED(SDSUPPORT)
-        case 1001: M1001(); break;                                // M1001: [INTERNAL] Handle SD completion
-      #endif
+    #if ENABLED(MAX7219_GCODE)
+      _M(7219, M7219),                                            // M7219: Set LEDs, columns, and rows
+    #endif
+  };
 
-      #if ENABLED(MAX7219_GCODE)
-        case 7219: M7219(); break;                                // M7219: Set LEDs, columns, and rows
-      #endif
+  #undef _G
+  #undef _GS
+  #undef _M
+
+  static constexpr uint16_t count = COUNT(table);
 
-      default: parser.unknown_command_warning(); break;
+  // G0-G3 are looked up by number
+  static constexpr uint8_t motion_count = (ENABLED(ARC_SUPPORT) && DISABLED(SCARA)) ? 4 : 2;
+
+  static constexpr bool is_sorted(const uint16_t i=1) {
+    return i >= count || (table[i - 1].key < table[i].key && is_sorted(i + 1));
+  }
+  static constexpr bool motion_first(const uint8_t i=0) {
+    return i >= motion_count || (table[i].key == GCODE_KEY('G', i, 0) && motion_first(i + 1));
+  }
+
+  static const entry_t* find(const char letter, const uint32_t codenum, const uint8_t subcode) {
+    static_assert(is_sorted(), "G-code dispatch table entries must be in ascending order, without duplicates.");
+    static_assert(motion_first(), "G-code dispatch table must start with the motion commands.");
+    if (subcode > 0xF) return find(letter, codenum, 0);   // Only 4 bits in the key
+    const uint32_t k = GCODE_KEY(letter, codenum, subcode);
+    uint16_t lo = 0, hi = count;
+    while (lo < hi) {
+      const uint16_t mid = (lo + hi) >> 1;
+      const uint32_t mk = pgm_read_dword(&table[mid].key);
+      if (mk == k) return &table[mid];
+      if (mk < k) lo = mid + 1; else hi = mid;
     }
-    break;
+    // Fall back to the entry for the whole command
+    return subcode ? find(letter, codenum, 0) : nullptr;
+  }
 
-    case 'T': T(parser.codenum); break;                           // Tn: Tool Change
+  #if ENABLED(GCODE_PROFILER)
+    // Invocations and time spent per table entry, plus one for T
+    static uint32_t calls[count + 1];
+    static uint64_t time_us[count + 1];
+    // Time spent in sub-commands of the running handler
+    static uint32_t nested_us;
+  #endif
+};
 
-    default:
-      #if ENABLED(WIFI_CUSTOM_COMMAND)
-        if (wifi_custom_command(parser.command_ptr)) break;
-      #endif
-      parser.unknown_command_warning();
+constexpr GcodeSuite::Dispatch::entry_t GcodeSuite::Dispatch::table[] PROGMEM;
+bool GcodeSuite::Dispatch::skip_ok; // = false
+
+#if ENABLED(GCODE_PROFILER)
+
+  uint32_t GcodeSuite::Dispatch::calls[GcodeSuite::Dispatch::count + 1]; // = { 0 }
+  uint64_t GcodeSuite::Dispatch::time_us[GcodeSuite::Dispatch::count + 1]; // = { 0 }
+  uint32_t GcodeSuite::Dispatch::nested_us; // = 0
+
+  /**
+   * Report the G-codes that were run, the most time-consuming first.
+   * The time includes any wait inside the handler (e.g., for the planner),
+   * but not sub-commands it runs, which are counted on their own entries.
+   */
+  void GcodeSuite::report_command_stats() {
+    uint64_t total_us = 0;
+    for (uint16_t i = 0; i <= Dispatch::count; i++) total_us += Dispatch::time_us[i];
+
+    uint8_t done[(Dispatch::count + 1 + 7) / 8] = { 0 };
+    for (;;) {
+      int16_t best = -1;
+      for (uint16_t i = 0; i <= Dispatch::count; i++)
+        if (Dispatch::calls[i] && !TEST(done[i >> 3], i & 7) && (best < 0 || Dispatch::time_us[i] > Dispatch::time_us[best]))
+          best = i;
+      if (best < 0) break;
+      SBI(done[best >> 3], best & 7);
+
+      SERIAL_ECHO_START();
+      if (best < Dispatch::count) {
+        const uint32_t k = pgm_read_dword(&Dispatch::table[best].key);
+        SERIAL_CHAR(char(k >> 24));
+        SERIAL_ECHO(uint16_t(k >> 4));
+        if (k & 0xF) { SERIAL_CHAR('.'); SERIAL_ECHO(uint8_t(k & 0xF)); }
+      }
+      else
+        SERIAL_CHAR('T');
+
+      const uint64_t t = Dispatch::time_us[best];
+      SERIAL_ECHOPAIR(" calls:", Dispatch::calls[best]);
+      SERIAL_ECHOPAIR(" time(ms):", uint32_t(t / 1000));
+      SERIAL_ECHOPAIR(" avg(us):", uint32_t(t / Dispatch::calls[best]));
+      SERIAL_ECHOLNPAIR(" share(%):", total_us ? uint8_t(t * 100 / total_us) : 0);
+    }
+  }
+
+  void GcodeSuite::reset_command_stats() {
+    ZERO(Dispatch::calls);
+    ZERO(Dispatch::time_us);
+  }
+
+#endif // GCODE_PROFILER
+
+/**
+ * Process the parsed command and dispatch it to its handler
+ */
+void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
+  KEEPALIVE_STATE(IN_HANDLER);
+
+ /**
+  * Block all Gcodes except M511 Unlock Printer, if printer is locked
+  * Will still block Gcodes if M511 is disabled, in which case the printer should be unlocked via LCD Menu
+  */
+  #if ENABLED(PASSWORD_FEATURE)
+    if (password.is_locked && !(parser.command_letter == 'M' && parser.codenum == 511)) {
+      SERIAL_ECHO_MSG(STR_PRINTER_LOCKED);
+      return;
+    }
+  #endif
+
+  // Deliver a held G1 segment before any other command runs
+  #if ENABLED(SEGMENT_COALESCING)
+    if (!(parser.command_letter == 'G' && parser.codenum <= 1)) coalescer.flush();
+  #endif
+
+  // Find the handler for a known G or M. Motion commands skip the search.
+  // Numbers that don't fit in a key are unknown.
+  const char letter = parser.command_letter;
+  const Dispatch::entry_t *entry = nullptr;
+  if ((letter == 'G' || letter == 'M') && WITHIN(parser.codenum, 0, GCODE_KEY_MAX_N)) {
+    if (letter == 'G' && parser.codenum < Dispatch::motion_count)
+      entry = &Dispatch::table[parser.codenum];
+    else
+      entry = Dispatch::find(letter, parser.codenum, TERN0(USE_GCODE_SUBCODES, parser.subcode));
   }
 
-  if (!no_ok) queue.ok_to_send();
+  // A sub-command run by the handler has its own "ok" flag
+  const bool outer_skip_ok = Dispatch::skip_ok;
+  Dispatch::skip_ok = false;
+
+  if (entry || letter == 'T') {
+    #if ENABLED(GCODE_PROFILER)
+      const uint32_t start_us = micros(), outer_nested_us = Dispatch::nested_us;
+      Dispatch::nested_us = 0;
+    #endif
+
+    if (entry) {
+      const Dispatch::handler_t handler = (Dispatch::handler_t)pgm_read_ptr(&entry->handler);
+      if (handler) handler();
+    }
+    else
+      T(parser.codenum);                                          // Tn: Tool Change
+
+    #if ENABLED(GCODE_PROFILER)
+      const uint16_t i = entry ? entry - Dispatch::table : Dispatch::count;
+      const uint32_t elapsed_us = micros() - start_us;
+      Dispatch::calls[i]++;
+      Dispatch::time_us[i] += elapsed_us - Dispatch::nested_us;
+      Dispatch::nested_us = outer_nested_us + elapsed_us;
+    #endif
+  }
+  else {
+    #if ENABLED(WIFI_CUSTOM_COMMAND)
+      if (letter == 'G' || letter == 'M' || !wifi_custom_command(parser.command_ptr))
+    #endif
+        parser.unknown_command_warning();
+  }
+
+  const bool skip_ok = Dispatch::skip_ok;
+  Dispatch::skip_ok = outer_skip_ok;
+
+  if (!no_ok && !skip_ok) queue.ok_to_send();
 }
 
 /**
@@ -945,12 +1160,12 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
-  char * const current_command = queue.command_buffer[queue.index_r];
+  char * const current_command = queue.command();
 
-  PORT_REDIRECT(queue.port[queue.index_r]);
+  PORT_REDIRECT(queue.command_port());
 
   #if ENABLED(POWER_LOSS_RECOVERY)
-    recovery.queue_index_r = queue.index_r;
+    recovery.queue_sdpos = queue.command_sdpos();
   #endif
 
   if (DEBUGGING(ECHO)) {
@@ -958,12 +1173,18 @@ void GcodeSuite::process_next_command() {
     SERIAL_ECHOLN(current_command);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPAIR("slot:", queue.index_r);
-      M100_dump_routine(PSTR("   Command Queue:"), &queue.command_buffer[0][0], &queue.command_buffer[BUFSIZE - 1][MAX_CMD_SIZE - 1]);
+      M100_dump_routine(PSTR("   Command Queue:"), queue.command_buffer, queue.command_buffer + sizeof(queue.command_buffer) - 1);
     #endif
   }
 
-  // Parse the next command in the queue
-  parser.parse(current_command);
+  // Parse the next command in the queue, unless it was parsed as it was queued
+  #if ENABLED(PREPARSED_COMMANDS)
+    const parsed_command_t &parsed = queue.header().parsed;
+    if (parsed.letter)
+      parser.load(current_command, parsed);
+    else
+  #endif
+      parser.parse(current_command);
   process_parsed_command();
 }
 
@@ -126,6 +126,7 @@
  * M85  - Set inactivity shutdown timer with parameter S<seconds>. To disable set zero (default)
  * M92  - Set planner.settings.axis_steps_per_mm for one or more axes.
  * M100 - Watch Free Memory (for debugging) (Requires M100_FREE_MEMORY_WATCHER)
+ * M101 - Report G-code calls and time spent per command. R to reset. (Requires GCODE_PROFILER)
  * M104 - Set extruder target temp.
  * M105 - Report current temperatures.
  * M106 - Set print fan speed.
@@ -146,6 +147,7 @@
  * M120 - Enable endstops detection.
  * M121 - Disable endstops detection.
  * M122 - Debug stepper (Requires at least one _DRIVER_TYPE defined as TMC2130/2160/5130/5160/2208/2209/2660 or L6470)
+ * M124 - Report the Stepper ISR cycle profile. R to reset. (Requires STEPPER_ISR_PROFILER)
  * M125 - Save current position and move to filament change position. (Requires PARK_HEAD_ON_PAUSE)
  * M126 - Solenoid Air Valve Open. (Requires BARICUDA)
  * M127 - Solenoid Air Valve Closed. (Requires BARICUDA)
@@ -184,6 +186,7 @@
  *        Use "M220 B" to back up the Feedrate Percentage and "M220 R" to restore it. (Requires PRUSA_MMU2)
  * M221 - Set Flow Percentage: "M221 S<percent>"
  * M226 - Wait until a pin is in a given state: "M226 P<pin> S<state>"
+ * M230 - Set segment coalescing tolerances and report counters: "M230 S<0|1> C<mm> A<deg> R". (Requires SEGMENT_COALESCING)
  * M240 - Trigger a camera to take a photograph. (Requires PHOTO_GCODE)
  * M250 - Set LCD contrast: "M250 C<contrast>" (0-63). (Requires LCD support)
  * M260 - i2c Send Data (Requires EXPERIMENTAL_I2CBUS)
@@ -231,6 +234,8 @@
  * M524 - Abort the current SD print job started with M24. (Requires SDSUPPORT)
  * M540 - Enable/disable SD card abort on endstop hit: "M540 S<state>". (Requires SD_ABORT_ON_ENDSTOP_HIT)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
+ * M576 - Report the binary motion protocol state. "M576 S1" switches the port to binary frames. (Requires BINARY_MOTION_PROTOCOL)
+ * M593 - Set input shaping for X and Y: "M593 [X] [Y] F<hz> D<zeta> T<type>". (Requires INPUT_SHAPING)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -356,6 +361,11 @@ public:
   static void process_parsed_command(const bool no_ok=false);
   static void process_next_command();
 
+  #if ENABLED(GCODE_PROFILER)
+    static void report_command_stats();
+    static void reset_command_stats();
+  #endif
+
   // Execute G-code in-place, preserving current G-code parameters
   static void process_subcommands_now_P(PGM_P pgcode);
   static void process_subcommands_now(char * gcode);
@@ -404,6 +414,8 @@ public:
 
 private:
 
+  struct Dispatch;  // G- and M-code dispatch table (gcode.cpp)
+
   static void G0_G1(
     #if IS_SCARA || defined(G0_FEEDRATE)
       const bool fast_move=false
@@ -565,6 +577,8 @@ private:
 
   TERN_(M100_FREE_MEMORY_WATCHER, static void M100());
 
+  TERN_(GCODE_PROFILER, static void M101());
+
   #if EXTRUDERS
     static void M104();
     static void M109();
@@ -597,6 +611,8 @@ private:
   static void M120();
   static void M121();
 
+  TERN_(STEPPER_ISR_PROFILER, static void M124());
+
   TERN_(PARK_HEAD_ON_PAUSE, static void M125());
 
   #if ENABLED(BARICUDA)
@@ -674,6 +690,8 @@ private:
 
   static void M226();
 
+  TERN_(SEGMENT_COALESCING, static void M230());
+
   TERN_(PHOTO_GCODE, static void M240());
 
   TERN_(HAS_LCD_CONTRAST, static void M250());
@@ -779,6 +797,10 @@ private:
 
   TERN_(BAUD_RATE_GCODE, static void M575());
 
+  TERN_(BINARY_MOTION_PROTOCOL, static void M576());
+
+  TERN_(INPUT_SHAPING, static void M593());
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
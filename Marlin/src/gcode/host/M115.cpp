@@ -99,6 +99,9 @@ void GcodeSuite::M115() {
     // EMERGENCY_PARSER (M108, M112, M410, M876)
     cap_line(PSTR("EMERGENCY_PARSER"), ENABLED(EMERGENCY_PARSER));
 
+    // SELECTIVE_RESEND (Resend: asks only for missing lines)
+    cap_line(PSTR("SELECTIVE_RESEND"), ENABLED(SELECTIVE_RESEND));
+
     // PROMPT SUPPORT (M876)
     cap_line(PSTR("PROMPT_SUPPORT"), ENABLED(HOST_PROMPT_SUPPORT));
 
@@ -123,6 +126,9 @@ void GcodeSuite::M115() {
     // BABYSTEPPING (M290)
     cap_line(PSTR("BABYSTEPPING"), ENABLED(BABYSTEPPING));
 
+    // BINARY_MOTION (M576)
+    cap_line(PSTR("BINARY_MOTION"), ENABLED(BINARY_MOTION_PROTOCOL));
+
     // CHAMBER_TEMPERATURE (M141, M191)
     cap_line(PSTR("CHAMBER_TEMPERATURE"), ENABLED(HAS_HEATED_CHAMBER));
 
@@ -24,6 +24,7 @@
 #if ENABLED(REPETIER_GCODE_M360)
 
 #include "../gcode.h"
+#include "../queue.h"
 
 #include "../../module/motion.h"
 #include "../../module/planner.h"
@@ -54,7 +55,7 @@ void GcodeSuite::M360() {
   //
   config_line(PSTR("Baudrate"), BAUDRATE);
   config_line(PSTR("InputBuffer"), MAX_CMD_SIZE);
-  config_line(PSTR("PrintlineCache"), BUFSIZE);
+  config_line(PSTR("PrintlineCache"), queue.free_commands());  // Longest commands that fit now
   config_line(PSTR("MixingExtruder"), ENABLED(MIXING_EXTRUDER));
   config_line(PSTR("SDCard"), ENABLED(SDSUPPORT));
   config_line(PSTR("Fan"), ENABLED(HAS_FAN));
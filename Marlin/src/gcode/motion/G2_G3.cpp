@@ -103,6 +103,62 @@ void plan_arc(
 
   const feedRate_t scaled_fr_mm_s = MMS_SCALED(feedrate_mm_s);
 
+  #if ENABLED(ARC_BLOCKS)
+    /**
+     * Queue XY arcs as native arc blocks for the Stepper to trace.
+     * Split the arc where it crosses an axis through the center so
+     * that X and Y each move one way and each piece stays inside the
+     * box set by its end points.
+     */
+    if (p_axis == X_AXIS && TERN1(HAS_LEVELING, !planner.leveling_active)) {
+      constexpr float quadrant = RADIANS(90), min_piece = 0.001f;
+      const float start_angle = ATAN2(rvec.b, rvec.a),
+                  dir = angular_travel < 0 ? -1 : 1;
+
+      // Angles where each piece ends, relative to the start
+      float piece_end[6];
+      uint8_t pieces = 0;
+      for (float a = (dir > 0 ? FLOOR(start_angle / quadrant) + 1 : CEIL(start_angle / quadrant) - 1) * quadrant - start_angle;
+           pieces < COUNT(piece_end) - 1 && dir * (angular_travel - a) > min_piece;
+           a += dir * quadrant
+      ) if (dir * a > min_piece) piece_end[pieces++] = a;
+      piece_end[pieces++] = angular_travel;
+
+      // End points of all pieces. Fall back to segments if any must be clipped.
+      xyze_pos_t piece_pos[COUNT(piece_end)];
+      bool clipped = false;
+      LOOP_L_N(i, pieces) {
+        xyze_pos_t &pos = piece_pos[i];
+        if (i == pieces - 1)
+          pos = cart;
+        else {
+          const float angle = start_angle + piece_end[i], fraction = piece_end[i] / angular_travel;
+          pos = current_position;
+          pos.x = center_P + radius * cos(angle);
+          pos.y = center_Q + radius * sin(angle);
+          pos.z = start_L + linear_travel * fraction;
+          pos.e += extruder_travel * fraction;
+        }
+        xyz_pos_t limited = pos;
+        apply_motion_limits(limited);
+        if (pos != limited) { clipped = true; break; }
+      }
+
+      if (!clipped) {
+        float piece_start = 0;
+        LOOP_L_N(i, pieces) {
+          const float travel = piece_end[i] - piece_start;
+          if (!planner.buffer_arc(piece_pos[i], radius, start_angle + piece_start, travel,
+                                  scaled_fr_mm_s, active_extruder, mm_of_travel * travel / angular_travel)
+          ) break;
+          piece_start = piece_end[i];
+        }
+        current_position = cart;
+        return;
+      }
+    }
+  #endif
+
   // Start with a nominal segment length
   float seg_length = (
     #ifdef ARC_SEGMENTS_PER_R
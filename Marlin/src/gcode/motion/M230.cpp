@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfigPre.h"
+
+#if ENABLED(SEGMENT_COALESCING)
+
+#include "../gcode.h"
+#include "../../feature/segment_coalescer.h"
+
+/**
+ * M230: Set segment coalescing tolerances and report counters
+ *
+ *   S<0|1>   Disable / enable coalescing
+ *   C<mm>    Chord tolerance, the max distance of a merged point from the combined move
+ *   A<deg>   Angle tolerance, the max direction change between merged segments
+ *   R        Reset the counters after reporting
+ */
+void GcodeSuite::M230() {
+  if (parser.seen('S')) {
+    coalescer.enabled = parser.value_bool();
+    if (!coalescer.enabled) coalescer.flush();
+  }
+  if (parser.seenval('C')) coalescer.chord_tolerance = _MAX(parser.value_linear_units(), 0);
+  if (parser.seenval('A')) coalescer.set_angle_tolerance(constrain(parser.value_float(), 0, 90));
+
+  coalescer.report();
+  if (parser.seen('R')) coalescer.reset();
+}
+
+#endif // SEGMENT_COALESCING
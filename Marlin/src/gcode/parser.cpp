@@ -66,6 +66,10 @@ int GCodeParser::codenum;
   // Optimized Parameters
   uint32_t GCodeParser::codebits;  // found bits
   uint8_t GCodeParser::param[26];  // parameter offsets from command_ptr
+  #if ENABLED(PREPARSED_COMMANDS)
+    const float *GCodeParser::values; // = nullptr
+    uint8_t GCodeParser::value_index;
+  #endif
 #else
   char *GCodeParser::command_args; // start of parameters
 #endif
@@ -87,6 +91,7 @@ void GCodeParser::reset() {
   #if ENABLED(FASTER_GCODE_PARSER)
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
+    TERN_(PREPARSED_COMMANDS, values = nullptr); // Values come from the string
   #endif
 }
 
@@ -110,6 +115,105 @@ void GCodeParser::reset() {
 
 #endif
 
+/**
+ * Scan a G-code number. Anything but a digit or the first point ends it,
+ * so 'E' is never an exponent, and no locale is involved.
+ *
+ * Up to 8 significant digits and 10 decimals the digits fit a float
+ * exactly, and a single division by an exact power of 10 gives the
+ * correctly rounded result. Longer numbers go to strtof.
+ */
+float GCodeParser::scan_float(const char *p) {
+  static const float pow10[] PROGMEM = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+  const char * const start = p;
+  const bool neg = *p == '-';
+  if (neg || *p == '+') ++p;
+
+  // Find the end of the number and the point
+  const char *point = nullptr, *end = p;
+  for (;; ++end) {
+    if (*end == '.' && !point) point = end;
+    else if (!NUMERIC(*end)) break;
+  }
+
+  // Zeros at the end of the decimals change nothing
+  const char *stop = end;
+  if (point) while (stop > point + 1 && stop[-1] == '0') --stop;
+
+  uint32_t digits = 0;
+  uint8_t decimals = 0;
+  for (const char *d = p; d < stop; ++d) {
+    if (d == point) continue;
+    if (digits > 0xFFFFFFUL) { digits = UINT32_MAX; break; } // Past float precision
+    digits = digits * 10 + (*d - '0');
+    if (point && d > point) ++decimals;
+  }
+
+  if (digits <= 0x1000000UL && decimals < COUNT(pow10)) {
+    const float f = float(digits) / pgm_read_float(&pow10[decimals]);
+    return neg ? -f : f;
+  }
+
+  // Too many digits to be exact. Let strtof round it.
+  char num[MAX_CMD_SIZE];
+  const size_t len = _MIN(size_t(end - start), sizeof(num) - 1);
+  memcpy(num, start, len);
+  num[len] = '\0';
+  return strtof(num, nullptr);
+}
+
+// Digits of an integer. Set 'neg' for a minus sign, 'over' if it doesn't fit 32 bits.
+static uint32_t scan_digits(const char *p, bool &neg, bool &over) {
+  neg = *p == '-';
+  over = false;
+  if (neg || *p == '+') ++p;
+  uint32_t n = 0;
+  for (; NUMERIC(*p); ++p) {
+    const uint8_t d = *p - '0';
+    if (n > (UINT32_MAX - d) / 10) { over = true; return UINT32_MAX; }
+    n = n * 10 + d;
+  }
+  return n;
+}
+
+// Like strtol with a 32-bit long, saturating
+int32_t GCodeParser::scan_long(const char *p) {
+  bool neg, over;
+  const uint32_t n = scan_digits(p, neg, over);
+  if (neg) return n > uint32_t(INT32_MAX) ? INT32_MIN : -int32_t(n);
+  return n > uint32_t(INT32_MAX) ? INT32_MAX : int32_t(n);
+}
+
+// Like strtoul with a 32-bit long. A minus sign negates, as in strtoul.
+uint32_t GCodeParser::scan_ulong(const char *p) {
+  bool neg, over;
+  const uint32_t n = scan_digits(p, neg, over);
+  return over ? UINT32_MAX : neg ? -n : n;
+}
+
+#if ENABLED(GCODE_MOTION_MODES)
+
+  // A motion command sets the mode for commands that are only parameters
+  void GCodeParser::set_motion_mode() {
+    #if ENABLED(ARC_SUPPORT)
+      #define GTOP 3
+    #else
+      #define GTOP 1
+    #endif
+    if (command_letter == 'G' && (codenum <= GTOP || codenum == 5
+                                    #if ENABLED(G38_PROBE_TARGET)
+                                      || codenum == 38
+                                    #endif
+                                 )
+    ) {
+      motion_mode_codenum = codenum;
+      TERN_(USE_GCODE_SUBCODES, motion_mode_subcode = subcode);
+    }
+  }
+
+#endif
+
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
 void GCodeParser::parse(char *p) {
@@ -147,14 +251,6 @@ void GCodeParser::parse(char *p) {
     starpos[1] = '\0';
   }
 
-  #if ENABLED(GCODE_MOTION_MODES)
-    #if ENABLED(ARC_SUPPORT)
-      #define GTOP 3
-    #else
-      #define GTOP 1
-    #endif
-  #endif
-
   // Bail if the letter is not G, M, or T
   // (or a valid parameter for the current motion mode)
   switch (letter) {
@@ -200,17 +296,7 @@ void GCodeParser::parse(char *p) {
       // Skip all spaces to get to the first argument, or nul
       while (*p == ' ') p++;
 
-      #if ENABLED(GCODE_MOTION_MODES)
-        if (letter == 'G' && (codenum <= GTOP || codenum == 5
-                                #if ENABLED(G38_PROBE_TARGET)
-                                  || codenum == 38
-                                #endif
-                             )
-        ) {
-          motion_mode_codenum = codenum;
-          TERN_(USE_GCODE_SUBCODES, motion_mode_subcode = subcode);
-        }
-      #endif
+      TERN_(GCODE_MOTION_MODES, set_motion_mode());
 
       break;
 
@@ -340,6 +426,98 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if ENABLED(PREPARSED_COMMANDS)
+
+  /**
+   * Parse a command as it goes into the queue, saving the state of the
+   * running command around it. Values are converted here, so the float
+   * scan is done while the planner is busy.
+   *
+   * A line of parameters for the current motion mode is left to be parsed
+   * when it runs, since the mode isn't known until then.
+   */
+  uint8_t GCodeParser::preparse(char * const cmd, parsed_command_t &pc) {
+    #if ENABLED(GCODE_QUOTED_STRINGS)
+      // Strings are unescaped in place, so parse only once, when it runs
+      if (strchr(cmd, '"')) { pc.letter = 0; return 0; }
+    #endif
+
+    char * const s_command_ptr = command_ptr, * const s_string_arg = string_arg, * const s_value_ptr = value_ptr;
+    const char s_command_letter = command_letter;
+    const int s_codenum = codenum;
+    const uint32_t s_codebits = codebits;
+    const float * const s_values = values;
+    const uint8_t s_value_index = value_index;
+    uint8_t s_param[COUNT(param)];
+    COPY(s_param, param);
+    #if ENABLED(USE_GCODE_SUBCODES)
+      const uint8_t s_subcode = subcode;
+    #endif
+    #if ENABLED(GCODE_MOTION_MODES)
+      const int16_t s_motion_mode_codenum = motion_mode_codenum;
+      #if ENABLED(USE_GCODE_SUBCODES)
+        const uint8_t s_motion_mode_subcode = motion_mode_subcode;
+      #endif
+      motion_mode_codenum = -1;         // Parameters alone are not a command here
+    #endif
+
+    parse(cmd);
+
+    uint8_t count = 0;
+    if (command_letter == '?' || int32_t(codenum) > INT16_MAX)
+      pc.letter = 0;                    // Parse it again when it runs
+    else {
+      pc.letter = command_letter;
+      pc.codenum = codenum;
+      pc.subcode = TERN0(USE_GCODE_SUBCODES, subcode);
+      pc.codebits = codebits;
+      pc.command_index = command_ptr - cmd;
+      pc.string_index = string_arg ? string_arg - cmd : 0;
+
+      // Values go after the string, aligned for floats
+      pc.values_index = (strlen(cmd) + sizeof(float)) & ~(sizeof(float) - 1);
+      float * const value = (float*)(cmd + pc.values_index);
+      uint8_t * const offset = (uint8_t*)(value + __builtin_popcountl(codebits));
+      LOOP_L_N(ind, COUNT(param)) if (TEST32(codebits, ind)) {
+        seen('A' + ind);
+        value[count] = value_float();
+        offset[count++] = param[ind];
+      }
+    }
+
+    command_ptr = s_command_ptr; string_arg = s_string_arg; value_ptr = s_value_ptr;
+    command_letter = s_command_letter;
+    codenum = s_codenum;
+    codebits = s_codebits;
+    values = s_values;
+    value_index = s_value_index;
+    COPY(param, s_param);
+    TERN_(USE_GCODE_SUBCODES, subcode = s_subcode);
+    #if ENABLED(GCODE_MOTION_MODES)
+      motion_mode_codenum = s_motion_mode_codenum;
+      TERN_(USE_GCODE_SUBCODES, motion_mode_subcode = s_motion_mode_subcode);
+    #endif
+
+    return count;
+  }
+
+  void GCodeParser::load(char * const cmd, const parsed_command_t &pc) {
+    command_ptr = cmd + pc.command_index;
+    string_arg = pc.string_index ? cmd + pc.string_index : nullptr;
+    command_letter = pc.letter;
+    codenum = pc.codenum;
+    TERN_(USE_GCODE_SUBCODES, subcode = pc.subcode);
+    TERN_(GCODE_MOTION_MODES, set_motion_mode());
+
+    codebits = pc.codebits;
+    values = (const float*)(cmd + pc.values_index);
+    const uint8_t * const offset = (const uint8_t*)(values + __builtin_popcountl(codebits));
+    uint8_t count = 0;
+    LOOP_L_N(ind, COUNT(param)) if (TEST32(codebits, ind)) param[ind] = offset[count++];
+  }
+
+#endif // PREPARSED_COMMANDS
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
@@ -42,6 +42,23 @@
   typedef enum : uint8_t { LINEARUNIT_MM, LINEARUNIT_INCH } LinearUnit;
 #endif
 
+#if ENABLED(PREPARSED_COMMANDS)
+  /**
+   * A command parsed when it was queued. The parameter values follow the
+   * command string as floats, then as offsets into the string, one of each
+   * for every parameter seen, in letter order.
+   */
+  typedef struct {
+    uint32_t codebits;              // Parameters seen
+    int16_t codenum;                // 123
+    char letter;                    // G, M, or T. 0 to parse the string when the command runs.
+    uint8_t subcode,                // .1
+            command_index,          // Offsets into the command string
+            string_index,           // ...of string_arg, or 0 for none
+            values_index;           // ...of the parameter values
+  } parsed_command_t;
+#endif
+
 /**
  * GCode parser
  *
@@ -62,6 +79,10 @@ private:
   #if ENABLED(FASTER_GCODE_PARSER)
     static uint32_t codebits;       // Parameters pre-scanned
     static uint8_t param[26];       // For A-Z, offsets into command args
+    #if ENABLED(PREPARSED_COMMANDS)
+      static const float *values;   // Parameter values converted when queued, or nullptr
+      static uint8_t value_index;   // Parameter of value_ptr
+    #endif
   #else
     static char *command_args;      // Args start here, for slow scan
   #endif
@@ -95,6 +116,7 @@ public:
       static uint8_t motion_mode_subcode;
     #endif
     FORCE_INLINE static void cancel_motion_mode() { motion_mode_codenum = -1; }
+    static void set_motion_mode();
   #endif
 
   #if ENABLED(DEBUG_GCODE_PARSER)
@@ -144,6 +166,7 @@ public:
       if (b) {
         char * const ptr = command_ptr + param[ind];
         value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
+        TERN_(PREPARSED_COMMANDS, value_index = ind);
       }
       return b;
     }
@@ -230,6 +253,13 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if ENABLED(PREPARSED_COMMANDS)
+    // Parse a queued command without disturbing the running one. Return the parameter count.
+    static uint8_t preparse(char * const cmd, parsed_command_t &pc);
+    // Populate all fields from a command parsed by preparse
+    static void load(char * const cmd, const parsed_command_t &pc);
+  #endif
+
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     // Parse the next parameter as a new command
     static bool chain();
@@ -244,29 +274,25 @@ public:
   // The value as a string
   static inline char* value_string() { return value_ptr; }
 
-  // Float removes 'E' to prevent scientific notation interpretation
+  // Scanners for G-code numbers, [-+]?[0-9]*.?[0-9]* with no exponent
+  static float scan_float(const char *p);
+  static int32_t scan_long(const char *p);
+  static uint32_t scan_ulong(const char *p);
+
+  // Float ignores 'E' since G-code has no scientific notation
   static inline float value_float() {
     if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
-        }
-        ++e;
-      }
-      return strtof(value_ptr, nullptr);
+      #if ENABLED(PREPARSED_COMMANDS)
+        if (values) return values[__builtin_popcountl(codebits & (_BV32(value_index) - 1))];
+      #endif
+      return scan_float(value_ptr);
     }
     return 0;
   }
 
   // Code value as a long or ulong
-  static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  static inline int32_t value_long() { return value_ptr ? scan_long(value_ptr) : 0L; }
+  static inline uint32_t value_ulong() { return value_ptr ? scan_ulong(value_ptr) : 0UL; }
 
   // Code value for use as time
   static inline millis_t value_millis() { return value_ulong(); }
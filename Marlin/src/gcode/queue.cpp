@@ -43,6 +43,10 @@ GCodeQueue queue;
   #include "../feature/binary_stream.h"
 #endif
 
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+  #include "../feature/binary_motion.h"
+#endif
+
 #if ENABLED(POWER_LOSS_RECOVERY)
   #include "../feature/powerloss.h"
 #endif
@@ -54,27 +58,39 @@ GCodeQueue queue;
  */
 long GCodeQueue::last_N[NUM_SERIAL];
 
+#if ENABLED(SELECTIVE_RESEND)
+  /**
+   * Lines that arrived after a missing one, held until it's resent.
+   * Line N goes in slot N % RESEND_WINDOW.
+   */
+  static char held_line[NUM_SERIAL][RESEND_WINDOW][MAX_CMD_SIZE];
+  static uint32_t held_mask[NUM_SERIAL];  // Slots in use
+  static long resend_N[NUM_SERIAL];       // The last line asked for by "Resend:"
+
+  inline uint8_t held_slot(const long n) { return uint32_t(n) % (RESEND_WINDOW); }
+#endif
+
 /**
  * GCode Command Queue
- * A simple ring buffer of BUFSIZE command strings.
+ * A ring buffer of packed command records. See queue.h.
  *
  * Commands are copied into this buffer by the command injectors
  * (immediate, serial, sd card) and they are processed sequentially by
  * the main loop. The gcode.process_next_command method parses the next
  * command and hands off execution to individual handler functions.
  */
-uint8_t GCodeQueue::length = 0,  // Count of commands in the queue
-        GCodeQueue::index_r = 0, // Ring buffer read position
-        GCodeQueue::index_w = 0; // Ring buffer write position
+uint8_t GCodeQueue::length = 0;   // Count of commands in the queue
+uint16_t GCodeQueue::index_r = 0, // Ring buffer read position
+         GCodeQueue::index_w = 0; // Ring buffer write position
 
-char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+char GCodeQueue::command_buffer[BUFSIZE * MAX_CMD_SIZE];
 
-/*
- * The port that the command was received on
- */
-#if HAS_MULTI_SERIAL
-  int16_t GCodeQueue::port[BUFSIZE];
-#endif
+// Records start on a header boundary
+#define RECORD_SIZE(N) ((sizeof(GCodeQueue::command_header_t) + (N) + alignof(GCodeQueue::command_header_t) - 1) & ~(alignof(GCodeQueue::command_header_t) - 1))
+// Parsed commands add a float and an offset per parameter, after the string
+constexpr uint16_t max_record = RECORD_SIZE(MAX_CMD_SIZE + TERN0(PREPARSED_COMMANDS, sizeof(float) - 1 + 26 * (sizeof(float) + 1)));
+static_assert(max_record <= 255, "MAX_CMD_SIZE is too large for the command queue.");
+static_assert(max_record <= sizeof(GCodeQueue::command_buffer), "BUFSIZE * MAX_CMD_SIZE is too small for the command queue.");
 
 /**
  * Serial command injection
@@ -83,8 +99,6 @@ char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
 // Number of characters read in the current line of serial input
 static int serial_count[NUM_SERIAL] = { 0 };
 
-bool send_ok[BUFSIZE];
-
 /**
  * Next Injected PROGMEM Command pointer. (nullptr == empty)
  * Internal commands are enqueued ahead of serial / SD commands.
@@ -96,10 +110,7 @@ PGM_P GCodeQueue::injected_commands_P; // = nullptr
  */
 char GCodeQueue::injected_commands[64]; // = { 0 }
 
-GCodeQueue::GCodeQueue() {
-  // Send "ok" after commands by default
-  LOOP_L_N(i, COUNT(send_ok)) send_ok[i] = true;
-}
+GCodeQueue::GCodeQueue() {}
 
 /**
  * Check whether there are any commands yet to be executed
@@ -115,6 +126,38 @@ void GCodeQueue::clear() {
   index_r = index_w = length = 0;
 }
 
+/**
+ * Check for a contiguous run of bytes that can take the longest command.
+ * Shorter commands leave the rest of the run for the next one.
+ */
+bool GCodeQueue::has_space() {
+  if (!length) return true;
+  if (length == 255) return false;
+  if (index_w > index_r)                                      // Free space after the writer, and before the reader
+    return sizeof(command_buffer) - index_w >= max_record || index_r >= max_record;
+  return index_r - index_w >= max_record;                     // Free space between the writer and the reader. None if they meet.
+}
+
+/**
+ * Count the longest commands that would fit, as a safe queue space for hosts
+ */
+uint8_t GCodeQueue::free_commands() {
+  if (!length) return sizeof(command_buffer) / max_record;
+  if (index_w > index_r)
+    return (sizeof(command_buffer) - index_w) / max_record + index_r / max_record;
+  return (index_r - index_w) / max_record;
+}
+
+char* GCodeQueue::next_command() {
+  if (!length)
+    index_r = index_w = 0;                                    // Start over so the whole buffer is free
+  else if (index_w > index_r && sizeof(command_buffer) - index_w < max_record) {
+    ((command_header_t*)&command_buffer[index_w])->size = 0;  // No room at the end. Wrap around.
+    index_w = 0;
+  }
+  return &command_buffer[index_w + sizeof(command_header_t)];
+}
+
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
@@ -123,10 +166,23 @@ void GCodeQueue::_commit_command(bool say_ok
     , int16_t p/*=-1*/
   #endif
 ) {
-  send_ok[index_w] = say_ok;
-  TERN_(HAS_MULTI_SERIAL, port[index_w] = p);
-  TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
-  if (++index_w >= BUFSIZE) index_w = 0;
+  command_header_t &h = *(command_header_t*)&command_buffer[index_w];
+  char * const cmd = &command_buffer[index_w + sizeof(command_header_t)];
+  #if ENABLED(PREPARSED_COMMANDS)
+    // Parse it now, unless it's only going to be written to a file
+    h.parsed.letter = 0;
+    const uint8_t count = TERN0(SDSUPPORT, card.flag.saving) ? 0 : parser.preparse(cmd, h.parsed);
+    h.size = h.parsed.letter
+      ? RECORD_SIZE(h.parsed.values_index + count * (sizeof(float) + 1))
+      : RECORD_SIZE(strlen(cmd) + 1);
+  #else
+    h.size = RECORD_SIZE(strlen(cmd) + 1);
+  #endif
+  h.send_ok = say_ok;
+  TERN_(HAS_MULTI_SERIAL, h.port = p);
+  TERN_(POWER_LOSS_RECOVERY, h.sdpos = recovery.cmd_sdpos);
+  index_w += h.size;
+  if (index_w >= sizeof(command_buffer)) index_w = 0;
   length++;
 }
 
@@ -174,8 +230,8 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
 #if ENABLED(DOGM_SHOW_LAYER)
   AnalyzeComment(cmd);
 #endif
-  if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(command_buffer[index_w], cmd);
+  if (*cmd == ';' || !has_space()) return false;
+  strncpy(next_command(), cmd, MAX_CMD_SIZE - 1)[MAX_CMD_SIZE - 1] = '\0';
   _commit_command(say_ok
     #if HAS_MULTI_SERIAL
       , pn
@@ -313,10 +369,10 @@ void GCodeQueue::ok_to_send() {
     if (pn < 0) return;
     PORT_REDIRECT(pn);                    // Reply to the serial port that sent the command
   #endif
-  if (!send_ok[index_r]) return;
+  if (length && !header().send_ok) return;
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_buffer[index_r];
+    char* p = command();
     if (*p == 'N') {
       SERIAL_ECHO(' ');
       SERIAL_ECHO(*p++);
@@ -324,7 +380,7 @@ void GCodeQueue::ok_to_send() {
         SERIAL_ECHO(*p++);
     }
     SERIAL_ECHOPAIR_P(SP_P_STR, int(planner.moves_free()),
-                      SP_B_STR, int(BUFSIZE - length));
+                      SP_B_STR, int(free_commands()));
   #endif
   SERIAL_EOL();
 }
@@ -339,7 +395,9 @@ void GCodeQueue::flush_and_request_resend() {
     if (pn < 0) return;
     PORT_REDIRECT(pn);                    // Reply to the serial port that sent the command
   #endif
-  SERIAL_FLUSH();
+  #if DISABLED(SELECTIVE_RESEND)
+    SERIAL_FLUSH();                       // Lines in flight will be sent again
+  #endif
   SERIAL_ECHOPGM(STR_RESEND);
   SERIAL_ECHOLN(last_N[pn] + 1);
   ok_to_send();
@@ -364,16 +422,118 @@ void GCodeQueue::gcode_line_error(PGM_P const err, const int8_t pn) {
   SERIAL_ERROR_START();
   serialprintPGM(err);
   SERIAL_ECHOLN(last_N[pn]);
-  while (read_serial(pn) != -1);          // Clear out the RX buffer
+  #if ENABLED(SELECTIVE_RESEND)
+    resend_N[pn] = last_N[pn] + 1;        // Asked for below. Lines in flight are kept to be held.
+  #else
+    while (read_serial(pn) != -1);        // Clear out the RX buffer
+  #endif
   flush_and_request_resend();
   serial_count[pn] = 0;
 }
 
+#if ENABLED(SELECTIVE_RESEND)
+
+  /**
+   * Hold a line that came before its turn, if it fits in the window,
+   * and ask for the missing line. A line already received gets an "ok"
+   * so every line sent is answered once.
+   *
+   * The window is the RESEND_WINDOW lines after the missing one.
+   */
+  void GCodeQueue::hold_line(const uint8_t p, const long n, const char * const command) {
+    if (n - last_N[p] > RESEND_WINDOW + 1) return gcode_line_error(PSTR(STR_ERR_LINE_NO), p);
+
+    const uint8_t slot = held_slot(n);
+    if (n <= last_N[p] || TEST32(held_mask[p], slot)) {
+      PORT_REDIRECT(p);
+      SERIAL_ECHOPGM(STR_OK);
+      #if ENABLED(ADVANCED_OK)
+        SERIAL_ECHOPAIR(" N", n);
+        SERIAL_ECHOPAIR_P(SP_P_STR, int(planner.moves_free()),
+                          SP_B_STR, int(free_commands()));
+      #endif
+      SERIAL_EOL();
+      return;
+    }
+
+    strcpy(held_line[p][slot], command);
+    SBI32(held_mask[p], slot);
+    request_missing_line(p);
+  }
+
+  // Ask once for the next line, while later lines are held
+  void GCodeQueue::request_missing_line(const uint8_t p) {
+    const long n = last_N[p] + 1;
+    if (!held_mask[p] || resend_N[p] == n) return;
+    resend_N[p] = n;
+    PORT_REDIRECT(p);
+    SERIAL_ECHOPGM(STR_RESEND);
+    SERIAL_ECHOLN(n);
+  }
+
+  // Queue the held lines that now follow the last line, as many as fit
+  void GCodeQueue::queue_held_lines(const uint8_t p) {
+    while (held_mask[p] && has_space()) {
+      const uint8_t slot = held_slot(last_N[p] + 1);
+      if (!TEST32(held_mask[p], slot)) return request_missing_line(p);
+      if (!queue_serial_line(p, held_line[p][slot])) return;   // Try again later
+      CBI32(held_mask[p], slot);
+      last_N[p]++;
+    }
+  }
+
+#endif // SELECTIVE_RESEND
+
 FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", but not "M290", etc
   const char * const m29 = strstr_P(cmd, PSTR("M29"));
   return m29 && !NUMERIC(m29[3]);
 }
 
+#if ENABLED(BINARY_MOTION_PROTOCOL)
+
+  FORCE_INLINE bool is_M576_S1(const char * const cmd) {  // matches "M576 S1", but not "M5760 S1", etc
+    const char * const m576 = strstr_P(cmd, PSTR("M576"));
+    if (!m576 || NUMERIC(m576[4])) return false;
+    const char * const s = strchr(m576 + 4, 'S');
+    return s && s[1] == '1';
+  }
+
+  /**
+   * Queue the commands of an accepted binary frame, as many as fit.
+   * The last one sends the "ok" for the frame.
+   */
+  void GCodeQueue::queue_binary_commands(const uint8_t p) {
+    while (binary_motion.pending(p) && has_space()) {
+      const bool last = binary_motion.next_command(p, next_command());
+      _commit_command(last
+        #if HAS_MULTI_SERIAL
+          , p
+        #endif
+      );
+    }
+  }
+
+  /**
+   * Take a byte of binary input. A frame with a good checksum and
+   * the next line number is accepted and its commands queued.
+   */
+  void GCodeQueue::binary_serial_char(const uint8_t p, const uint8_t c) {
+    switch (binary_motion.receive(p, c)) {
+      case BinaryMotion::NEED_MORE: break;
+      case BinaryMotion::FRAME_OK:
+        if (binary_motion.frame_seq(p) != uint8_t(last_N[p] + 1))
+          return gcode_line_error(PSTR(STR_ERR_LINE_NO), p);
+        last_N[p]++;
+        binary_motion.accept(p);
+        queue_binary_commands(p);
+        break;
+      case BinaryMotion::BAD_CHECKSUM: return gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), p);
+      case BinaryMotion::BAD_FRAME: return gcode_line_error(PSTR(STR_ERR_BAD_FRAME), p);
+    }
+  }
+
+#endif // BINARY_MOTION_PROTOCOL
+
 #define PS_NORMAL 0
 #define PS_EOL    1
 #define PS_QUOTED 2
@@ -396,7 +556,7 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
   #define PS_EOL_CP 117
 #endif
 
-inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline void process_stream_char(const char c, uint8_t &sis, char * const buff, int &ind) {
 #if ENABLED(DOGM_SHOW_LAYER)
   switch(sis) {
     case PS_EOL:
@@ -556,7 +716,7 @@ inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD
  * Handle a line being completed. For an empty line
  * keep sensor readings going and watchdog alive.
  */
-inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline bool process_line_done(uint8_t &sis, char * const buff, int &ind) {
   sis = PS_NORMAL;
   buff[ind] = 0;
   if (ind) { ind = 0; return false; }
@@ -564,6 +724,57 @@ inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind
   return true;
 }
 
+/**
+ * Queue a line from a serial port that passed the line number checks.
+ * Return false if there was no room for it.
+ */
+bool GCodeQueue::queue_serial_line(const uint8_t p, char * const command) {
+  //
+  // Movement commands give an alert when the machine is stopped
+  //
+
+  if (IsStopped()) {
+    char* gpos = strchr(command, 'G');
+    if (gpos) {
+      switch (strtol(gpos + 1, nullptr, 10)) {
+        case 0: case 1:
+        #if ENABLED(ARC_SUPPORT)
+          case 2: case 3:
+        #endif
+        #if ENABLED(BEZIER_CURVE_SUPPORT)
+          case 5:
+        #endif
+          PORT_REDIRECT(p);                      // Reply to the serial port that sent the command
+          SERIAL_ECHOLNPGM(STR_ERR_STOPPED);
+          LCD_MESSAGEPGM(MSG_STOPPED);
+          break;
+      }
+    }
+  }
+
+  #if ENABLED(BINARY_MOTION_PROTOCOL)
+    // Frames may follow right away. M576 still runs to send "ok".
+    if (is_M576_S1(command)) binary_motion.set_active(p, true);
+  #endif
+
+  #if DISABLED(EMERGENCY_PARSER)
+    // Process critical commands early
+    if (strcmp_P(command, PSTR("M108")) == 0) {
+      wait_for_heatup = false;
+      TERN_(HAS_LCD_MENU, wait_for_user = false);
+    }
+    if (strcmp_P(command, PSTR("M112")) == 0) kill(M112_KILL_STR, nullptr, true);
+    if (strcmp_P(command, PSTR("M410")) == 0) quickstop_stepper();
+  #endif
+
+  // Add the command to the queue
+  return _enqueue(command, true
+    #if HAS_MULTI_SERIAL
+      , p
+    #endif
+  );
+}
+
 /**
  * Get all commands waiting on the serial port and queue them.
  * Exit when the buffer is full or when no more characters are
@@ -597,15 +808,35 @@ void GCodeQueue::get_serial_commands() {
     }
   #endif
 
+  // Queue the rest of binary frames that didn't fit
+  #if ENABLED(BINARY_MOTION_PROTOCOL)
+    LOOP_L_N(i, NUM_SERIAL) queue_binary_commands(i);
+  #endif
+
+  // Queue held lines that didn't fit
+  #if ENABLED(SELECTIVE_RESEND)
+    LOOP_L_N(i, NUM_SERIAL) queue_held_lines(i);
+  #endif
+
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
-  while (length < BUFSIZE && serial_data_available()) {
+  while (has_space() && serial_data_available()) {
     LOOP_L_N(i, NUM_SERIAL) {
 
+      // Wait for room for the rest of a frame
+      if (TERN0(BINARY_MOTION_PROTOCOL, binary_motion.pending(i))) continue;
+
       const int c = read_serial(i);
       if (c < 0) continue;
 
+      #if ENABLED(BINARY_MOTION_PROTOCOL)
+        if (binary_motion.active(i)) {
+          binary_serial_char(i, c);
+          continue;
+        }
+      #endif
+
       const char serial_char = c;
 
       if (ISEOL(serial_char)) {
@@ -646,8 +877,10 @@ void GCodeQueue::get_serial_commands() {
 
           const long gcode_N = strtol(npos + 1, nullptr, 10);
 
-          if (gcode_N != last_N[i] + 1 && !M110)
-            return gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
+          #if DISABLED(SELECTIVE_RESEND)
+            if (gcode_N != last_N[i] + 1 && !M110)
+              return gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
+          #endif
 
           char *apos = strrchr(command, '*');
           if (apos) {
@@ -659,6 +892,16 @@ void GCodeQueue::get_serial_commands() {
           else
             return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
 
+          #if ENABLED(SELECTIVE_RESEND)
+            // With a good checksum the line number can be trusted
+            if (M110)
+              held_mask[i] = 0, resend_N[i] = gcode_N;
+            else if (gcode_N != last_N[i] + 1) {
+              hold_line(i, gcode_N, command);
+              continue;
+            }
+          #endif
+
           last_N[i] = gcode_N;
         }
         #if ENABLED(SDSUPPORT)
@@ -667,49 +910,14 @@ void GCodeQueue::get_serial_commands() {
             return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
         #endif
 
-        //
-        // Movement commands give an alert when the machine is stopped
-        //
-
-        if (IsStopped()) {
-          char* gpos = strchr(command, 'G');
-          if (gpos) {
-            switch (strtol(gpos + 1, nullptr, 10)) {
-              case 0: case 1:
-              #if ENABLED(ARC_SUPPORT)
-                case 2: case 3:
-              #endif
-              #if ENABLED(BEZIER_CURVE_SUPPORT)
-                case 5:
-              #endif
-                PORT_REDIRECT(i);                      // Reply to the serial port that sent the command
-                SERIAL_ECHOLNPGM(STR_ERR_STOPPED);
-                LCD_MESSAGEPGM(MSG_STOPPED);
-                break;
-            }
-          }
-        }
-
-        #if DISABLED(EMERGENCY_PARSER)
-          // Process critical commands early
-          if (strcmp_P(command, PSTR("M108")) == 0) {
-            wait_for_heatup = false;
-            TERN_(HAS_LCD_MENU, wait_for_user = false);
-          }
-          if (strcmp_P(command, PSTR("M112")) == 0) kill(M112_KILL_STR, nullptr, true);
-          if (strcmp_P(command, PSTR("M410")) == 0) quickstop_stepper();
-        #endif
-
         #if defined(NO_TIMEOUTS) && NO_TIMEOUTS > 0
           last_command_time = ms;
         #endif
 
-        // Add the command to the queue
-        _enqueue(serial_line_buffer[i], true
-          #if HAS_MULTI_SERIAL
-            , i
-          #endif
-        );
+        queue_serial_line(i, command);
+
+        // Queue lines held for this one
+        TERN_(SELECTIVE_RESEND, queue_held_lines(i));
       }
       else
         process_stream_char(serial_char, serial_input_state[i], serial_line_buffer[i], serial_count[i]);
@@ -721,60 +929,128 @@ void GCodeQueue::get_serial_commands() {
 #if ENABLED(SDSUPPORT)
 
   /**
-   * Get lines from the SD Card until the command buffer is full
-   * or until the end of the file is reached. Because this method
-   * always receives complete command-lines, they can go directly
-   * into the main command queue.
+   * Handle the end of a line read from the SD card. Update the layer
+   * display and commit a non-empty command.
    */
-  inline void GCodeQueue::get_sdcard_commands() {
-    static uint8_t sd_input_state = PS_NORMAL;
-
-    if (!IS_SD_PRINTING()) return;
+  void GCodeQueue::sd_line_done(uint8_t &sis, char * const cmd, int &ind) {
+#if ENABLED(DOGM_SHOW_LAYER)
+    switch(sis) {
+      case PS_EOL_LP:
+        dogmLayer = runLayer + 1;
+        if(dogmLayer == 1 && !lastLayerCountEncountered)
+          dogmLayerCnt = 0;
+        lastLayerCountEncountered = false;
+        break;
+      case PS_EOL_CP:
+        dogmLayerCnt = runLayerCnt;
+        lastLayerCountEncountered = true;
+        break;
+      default:
+        if(ind > 1) lastLayerCountEncountered = false;
+        break;
+    }
+#endif
 
-    int sd_count = 0;
-    bool card_eof = card.eof();
-    while (length < BUFSIZE && !card_eof) {
-      const int16_t n = card.get();
-      card_eof = card.eof();
-      if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+    // Reset stream state, terminate the buffer, and commit a non-empty command
+    if (!process_line_done(sis, cmd, ind)) {
+      _commit_command(false);
+      #if ENABLED(POWER_LOSS_RECOVERY)
+        recovery.cmd_sdpos = card.getIndex();     // Prime for the NEXT _commit_command
+      #endif
+    }
+  }
 
-      const char sd_char = (char)n;
-      const bool is_eol = ISEOL(sd_char);
-      if (is_eol || card_eof) {
-#if ENABLED(DOGM_SHOW_LAYER)
-        switch(sd_input_state) {
-          case PS_EOL_LP:
-            dogmLayer = runLayer + 1;
-            if(dogmLayer == 1 && !lastLayerCountEncountered)
-              dogmLayerCnt = 0;
-            lastLayerCountEncountered = false;
-            break;
-          case PS_EOL_CP:
-            dogmLayerCnt = runLayerCnt;
-            lastLayerCountEncountered = true;
-            break;
-          default:
-            if(sd_count > 1) lastLayerCountEncountered = false;
-            break;
+  #if ENABLED(SD_READ_AHEAD)
+
+    // Past this state the rest of the line is ignored
+    #define PS_SKIP TERN(DOGM_SHOW_LAYER, PS_EOL_SKIP, PS_EOL)
+
+    /**
+     * Get lines from the SD Card until the command buffer is full
+     * or until the end of the file is reached. Because this method
+     * always receives complete command-lines, they can go directly
+     * into the main command queue.
+     *
+     * Lines are scanned straight out of the card's read-ahead blocks and
+     * comments are skipped to the end of the line without going through
+     * the line parser. With the queue full, read the next block early.
+     */
+    inline void GCodeQueue::get_sdcard_commands() {
+      static uint8_t sd_input_state = PS_NORMAL;
+
+      if (!IS_SD_PRINTING()) return;
+
+      int sd_count = 0;
+      uint32_t line_start = card.getIndex();
+      while (has_space()) {
+        char * const cmd = next_command();
+        uint16_t len;
+        const char * const buf = card.read_ahead(len);
+        if (!buf) {
+          if (!card.eof()) {
+            SERIAL_ERROR_MSG(STR_SD_ERR_READ);
+            card.setIndex(line_start);                  // Read the whole line again next time
+            sd_input_state = PS_NORMAL;
+            return;
+          }
+          sd_line_done(sd_input_state, cmd, sd_count);  // End of file with no newline
+          card.fileHasFinished();                       // Handle end of file reached
+          return;
         }
-#endif
 
-        // Reset stream state, terminate the buffer, and commit a non-empty command
-        if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command_buffer[index_w], sd_count)) {
-          _commit_command(false);
-          #if ENABLED(POWER_LOSS_RECOVERY)
-            recovery.cmd_sdpos = card.getIndex();     // Prime for the NEXT _commit_command
-          #endif
+        uint16_t i = 0;
+        while (i < len && !ISEOL(buf[i])) {
+          if (sd_input_state == PS_SKIP)
+            do ++i; while (i < len && !ISEOL(buf[i]));
+          else
+            process_stream_char(buf[i++], sd_input_state, cmd, sd_count);
         }
+        card.consume(i);
+        if (i == len) continue;                         // The line goes on in the next block
 
-        if (card_eof) card.fileHasFinished();         // Handle end of file reached
+        sd_line_done(sd_input_state, cmd, sd_count);    // getIndex() is at the EOL here
+        card.consume(1);
+        line_start = card.getIndex();
       }
-      else
-        process_stream_char(sd_char, sd_input_state, command_buffer[index_w], sd_count);
 
+      card.prefetch();
     }
-  }
+
+  #else
+
+    /**
+     * Get lines from the SD Card until the command buffer is full
+     * or until the end of the file is reached. Because this method
+     * always receives complete command-lines, they can go directly
+     * into the main command queue.
+     */
+    inline void GCodeQueue::get_sdcard_commands() {
+      static uint8_t sd_input_state = PS_NORMAL;
+
+      if (!IS_SD_PRINTING()) return;
+
+      int sd_count = 0;
+      bool card_eof = card.eof();
+      while (has_space() && !card_eof) {
+        char * const cmd = next_command();
+        const int16_t n = card.get();
+        card_eof = card.eof();
+        if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        const char sd_char = (char)n;
+        const bool is_eol = ISEOL(sd_char);
+        if (is_eol || card_eof) {
+          if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
+          sd_line_done(sd_input_state, cmd, sd_count);
+          if (card_eof) card.fileHasFinished();         // Handle end of file reached
+        }
+        else
+          process_stream_char(sd_char, sd_input_state, cmd, sd_count);
+
+      }
+    }
+
+  #endif // !SD_READ_AHEAD
 
 #endif // SDSUPPORT
 
@@ -805,8 +1081,8 @@ void GCodeQueue::advance() {
   #if ENABLED(SDSUPPORT)
 
     if (card.flag.saving) {
-      char* command = command_buffer[index_r];
-      if (is_M29(command)) {
+      char * const cmd = command();
+      if (is_M29(cmd)) {
         // M29 closes the file
         card.closefile();
         SERIAL_ECHOLNPGM(STR_FILE_SAVED);
@@ -824,7 +1100,7 @@ void GCodeQueue::advance() {
       }
       else {
         // Write the string from the read buffer to SD
-        card.write_command(command);
+        card.write_command(cmd);
         if (card.flag.logging)
           gcode.process_next_command(); // The card is saving because it's logging
         else
@@ -841,7 +1117,10 @@ void GCodeQueue::advance() {
   #endif // SDSUPPORT
 
   // The queue may be reset by a command handler or by code invoked by idle() within a handler
-  --length;
-  if (++index_r >= BUFSIZE) index_r = 0;
+  if (length) {
+    --length;
+    index_r += header().size;
+    if (index_r >= sizeof(command_buffer) || (length && !header().size)) index_r = 0;
+  }
 
 }
@@ -28,6 +28,10 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(PREPARSED_COMMANDS)
+  #include "parser.h"
+#endif
+
 class GCodeQueue {
 public:
   /**
@@ -40,29 +44,57 @@ public:
 
   /**
    * GCode Command Queue
-   * A simple ring buffer of BUFSIZE command strings.
+   * A ring buffer of BUFSIZE * MAX_CMD_SIZE bytes holding packed records,
+   * each a header followed by the command string. A header with size 0
+   * marks the end of the records before the ring wraps around.
    *
    * Commands are copied into this buffer by the command injectors
    * (immediate, serial, sd card) and they are processed sequentially by
    * the main loop. The gcode.process_next_command method parses the next
    * command and hands off execution to individual handler functions.
    */
-  static uint8_t length,  // Count of commands in the queue
-                 index_r; // Ring buffer read position
+  typedef struct {
+    uint8_t size;             // Bytes from this record to the next. 0 = wrap to the start.
+    bool send_ok;             // Send "ok" after the command runs
+    #if HAS_MULTI_SERIAL
+      int8_t port;            // The port that the command was received on
+    #endif
+    #if ENABLED(PREPARSED_COMMANDS)
+      parsed_command_t parsed;  // The command, parsed when it was queued
+    #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      uint32_t sdpos;         // SD position of the command
+    #endif
+  } command_header_t;
 
-  static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+  static uint8_t length;      // Count of commands in the queue
+  static uint16_t index_r;    // Ring buffer read position, in bytes
 
-  /**
-   * The port that the command was received on
-   */
-  #if HAS_MULTI_SERIAL
-    static int16_t port[BUFSIZE];
-  #endif
+  alignas(command_header_t) static char command_buffer[BUFSIZE * MAX_CMD_SIZE];
+
+  static inline command_header_t& header() { return *(command_header_t*)&command_buffer[index_r]; }
+
+  // The command to run next
+  static inline char* command() { return &command_buffer[index_r + sizeof(command_header_t)]; }
 
   static int16_t command_port() {
-    return TERN0(HAS_MULTI_SERIAL, port[index_r]);
+    return TERN0(HAS_MULTI_SERIAL, length ? header().port : 0);
   }
 
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    static inline uint32_t command_sdpos() { return header().sdpos; }
+  #endif
+
+  /**
+   * Room for one more command of any length
+   */
+  static bool has_space();
+
+  /**
+   * Worst-case count of commands that still fit
+   */
+  static uint8_t free_commands();
+
   GCodeQueue();
 
   /**
@@ -149,12 +181,29 @@ public:
 
 private:
 
-  static uint8_t index_w;  // Ring buffer write position
+  static uint16_t index_w;  // Ring buffer write position, in bytes
+
+  // Where the next command string goes. Only call with space in the queue.
+  static char* next_command();
 
   static void get_serial_commands();
 
+  static bool queue_serial_line(const uint8_t p, char * const command);
+
+  #if ENABLED(SELECTIVE_RESEND)
+    static void hold_line(const uint8_t p, const long n, const char * const command);
+    static void queue_held_lines(const uint8_t p);
+    static void request_missing_line(const uint8_t p);
+  #endif
+
+  #if ENABLED(BINARY_MOTION_PROTOCOL)
+    static void binary_serial_char(const uint8_t p, const uint8_t c);
+    static void queue_binary_commands(const uint8_t p);
+  #endif
+
   #if ENABLED(SDSUPPORT)
     static void get_sdcard_commands();
+    static void sd_line_done(uint8_t &sis, char * const cmd, int &ind);
   #endif
 
   static void _commit_command(bool say_ok
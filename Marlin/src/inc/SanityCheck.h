@@ -583,6 +583,18 @@
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
 #endif
 
+#if ENABLED(BINARY_MOTION_PROTOCOL) && !WITHIN(BINARY_MOTION_FRAME_SIZE, 16, 250)
+  #error "BINARY_MOTION_FRAME_SIZE must be from 16 to 250."
+#endif
+
+#if ENABLED(SELECTIVE_RESEND)
+  #if !WITHIN(RESEND_WINDOW, 2, 32)
+    #error "RESEND_WINDOW must be from 2 to 32."
+  #elif defined(__AVR__) && RESEND_WINDOW * MAX_CMD_SIZE > 512
+    #error "SELECTIVE_RESEND needs RESEND_WINDOW * MAX_CMD_SIZE bytes of RAM per serial port. Keep it within 512 bytes on AVR."
+  #endif
+#endif
+
 #if SERIAL_PORT > 7
   #error "Set SERIAL_PORT to the port on your board. Usually this is 0."
 #endif
@@ -2682,6 +2694,46 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
 
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "BLOCK_BUFFER_SIZE must be a power of 2."
+#elif defined(__AVR__) && BLOCK_BUFFER_SIZE > 64
+  #error "BLOCK_BUFFER_SIZE over 64 needs 16-bit block indices, which AVR can't read atomically."
+#elif defined(PLANNER_WINDOW_SIZE) && !WITHIN(PLANNER_WINDOW_SIZE, 2, (BLOCK_BUFFER_SIZE) - 1)
+  #error "PLANNER_WINDOW_SIZE must be from 2 to BLOCK_BUFFER_SIZE - 1."
+#endif
+
+#if ENABLED(SEGMENT_COALESCING)
+  #if IS_KINEMATIC
+    #error "SEGMENT_COALESCING is not compatible with DELTA or SCARA."
+  #elif ENABLED(LASER_POWER_INLINE)
+    #error "SEGMENT_COALESCING can't merge moves that carry LASER_POWER_INLINE power changes."
+  #elif !WITHIN(COALESCE_MAX_SEGMENTS, 2, 255)
+    #error "COALESCE_MAX_SEGMENTS must be from 2 to 255."
+  #endif
+#endif
+
+#if ENABLED(ARC_BLOCKS)
+  #if DISABLED(ARC_SUPPORT)
+    #error "ARC_BLOCKS requires ARC_SUPPORT."
+  #elif defined(__AVR__)
+    #error "ARC_BLOCKS needs 32-bit math in the Stepper ISR and isn't available for AVR."
+  #elif IS_KINEMATIC || IS_CORE
+    #error "ARC_BLOCKS requires a Cartesian XY machine."
+  #elif ENABLED(BACKLASH_COMPENSATION)
+    #error "ARC_BLOCKS is not compatible with BACKLASH_COMPENSATION."
+  #elif ENABLED(SKEW_CORRECTION)
+    #error "ARC_BLOCKS is not compatible with SKEW_CORRECTION."
+  #endif
+#endif
+
+#if ENABLED(INPUT_SHAPING)
+  #if IS_KINEMATIC || IS_CORE
+    #error "INPUT_SHAPING requires a Cartesian XY machine."
+  #elif ENABLED(BABYSTEP_XY)
+    #error "INPUT_SHAPING is not compatible with BABYSTEP_XY."
+  #elif !WITHIN(SHAPING_BUFFER_SIZE, 16, 65535)
+    #error "SHAPING_BUFFER_SIZE must be between 16 and 65535."
+  #elif !(SHAPING_MIN_FREQ > 0 && SHAPING_MIN_FREQ < SHAPING_MAX_FREQ)
+    #error "SHAPING_MIN_FREQ must be above 0 and below SHAPING_MAX_FREQ."
+  #endif
 #endif
 
 #if ENABLED(LED_CONTROL_MENU) && DISABLED(ULTIPANEL)
@@ -2706,6 +2758,10 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #endif
 #endif
 
+#if ENABLED(POWER_LOSS_JOURNAL) && !WITHIN(POWER_LOSS_JOURNAL_SLOTS, 2, 1024)
+  #error "POWER_LOSS_JOURNAL_SLOTS must be from 2 to 1024."
+#endif
+
 #if ENABLED(BACKUP_POWER_SUPPLY) && !PIN_EXISTS(POWER_LOSS)
   #error "BACKUP_POWER_SUPPLY requires a POWER_LOSS_PIN."
 #endif
@@ -2728,6 +2784,22 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #error "USB_CS_PIN and USB_INTR_PIN are required for USB_FLASH_DRIVE_SUPPORT."
 #endif
 
+#if ENABLED(SD_MULTIBLOCK_READ) && ANY(SDIO_SUPPORT, USB_FLASH_DRIVE_SUPPORT)
+  #error "SD_MULTIBLOCK_READ is only for SD cards on SPI."
+#endif
+
+#if defined(SD_FILE_EXTENTS) && !WITHIN(SD_FILE_EXTENTS, 1, 255)
+  #error "SD_FILE_EXTENTS must be from 1 to 255."
+#endif
+
+#if ENABLED(SD_WRITE_BEHIND)
+  #if !WITHIN(SD_WRITE_BEHIND_BLOCKS, 1, 127)
+    #error "SD_WRITE_BEHIND_BLOCKS must be from 1 to 127."
+  #elif ENABLED(SDCARD_READONLY)
+    #error "SD_WRITE_BEHIND can't be used with SDCARD_READONLY."
+  #endif
+#endif
+
 #if ENABLED(SD_FIRMWARE_UPDATE) && !defined(__AVR_ATmega2560__)
   #error "SD_FIRMWARE_UPDATE requires an ATmega2560-based (Arduino Mega) board."
 #endif
@@ -2736,6 +2808,10 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #error "GCODE_MACROS_SLOTS must be a number from 1 to 10."
 #endif
 
+#if ENABLED(PREPARSED_COMMANDS) && DISABLED(FASTER_GCODE_PARSER)
+  #error "PREPARSED_COMMANDS requires FASTER_GCODE_PARSER."
+#endif
+
 #if ENABLED(CUSTOM_USER_MENUS)
   #ifdef USER_GCODE_1
     constexpr char _chr1 = USER_GCODE_1[strlen(USER_GCODE_1) - 1];
@@ -3103,6 +3179,13 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #endif
 #endif
 
+/**
+ * Sanity Check for the Stepper ISR profiler
+ */
+#if ENABLED(STEPPER_ISR_PROFILER) && !defined(HAL_CYCLE_COUNTER)
+  #error "STEPPER_ISR_PROFILER requires a HAL cycle counter (HAL_CYCLE_COUNTER). Supported on LPC1768 and x86 LINUX."
+#endif
+
 #if SD_CONNECTION_IS(LCD_AND_ONBOARD) && !defined(HAS_GRAPHICAL_LCD)
 #error "LCD_AND_ONBOARD requires a graphical LCD with SD card (e.g. FYSETC_MINI_12864_2_1)"
 #endif
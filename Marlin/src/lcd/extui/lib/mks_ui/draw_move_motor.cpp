@@ -52,7 +52,7 @@ static void event_handler(lv_obj_t * obj, lv_event_t event) {
         // nothing to do
       }
       else if (event == LV_EVENT_RELEASED) {
-        if (queue.length <= (BUFSIZE - 3)) {
+        if (queue.free_commands() >= 3) {
           ZERO(public_buf_l);
           queue.enqueue_one_P(PSTR("G91"));
           sprintf_P(public_buf_l, PSTR("G1 X%3.1f F%d"), uiCfg.move_dist, uiCfg.moveSpeed);
@@ -66,7 +66,7 @@ static void event_handler(lv_obj_t * obj, lv_event_t event) {
         // nothing to do
       }
       else if (event == LV_EVENT_RELEASED) {
-        if (queue.length <= (BUFSIZE - 3)) {
+        if (queue.free_commands() >= 3) {
           ZERO(public_buf_l);
           queue.enqueue_now_P(PSTR("G91"));
           sprintf_P(public_buf_l, PSTR("G1 X-%3.1f F%d"), uiCfg.move_dist, uiCfg.moveSpeed);
@@ -80,7 +80,7 @@ static void event_handler(lv_obj_t * obj, lv_event_t event) {
         // nothing to do
       }
       else if (event == LV_EVENT_RELEASED) {
-        if (queue.length <= (BUFSIZE - 3)) {
+        if (queue.free_commands() >= 3) {
           ZERO(public_buf_l);
           queue.enqueue_now_P(PSTR("G91"));
           sprintf_P(public_buf_l, PSTR("G1 Y%3.1f F%d"), uiCfg.move_dist, uiCfg.moveSpeed);
@@ -94,7 +94,7 @@ static void event_handler(lv_obj_t * obj, lv_event_t event) {
         // nothing to do
       }
       else if (event == LV_EVENT_RELEASED) {
-        if (queue.length <= (BUFSIZE - 3)) {
+        if (queue.free_commands() >= 3) {
           ZERO(public_buf_l);
           queue.enqueue_now_P(PSTR("G91"));
           sprintf_P(public_buf_l, PSTR("G1 Y-%3.1f F%d"), uiCfg.move_dist, uiCfg.moveSpeed);
@@ -108,7 +108,7 @@ static void event_handler(lv_obj_t * obj, lv_event_t event) {
         // nothing to do
       }
       else if (event == LV_EVENT_RELEASED) {
-        if (queue.length <= (BUFSIZE - 3)) {
+        if (queue.free_commands() >= 3) {
           ZERO(public_buf_l);
           queue.enqueue_now_P(PSTR("G91"));
           sprintf_P(public_buf_l, PSTR("G1 Z%3.1f F%d"), uiCfg.move_dist, uiCfg.moveSpeed);
@@ -122,7 +122,7 @@ static void event_handler(lv_obj_t * obj, lv_event_t event) {
         // nothing to do
       }
       else if (event == LV_EVENT_RELEASED) {
-        if (queue.length <= (BUFSIZE - 3)) {
+        if (queue.free_commands() >= 3) {
           ZERO(public_buf_l);
           queue.enqueue_now_P(PSTR("G91"));
           sprintf_P(public_buf_l, PSTR("G1 Z-%3.1f F%d"), uiCfg.move_dist, uiCfg.moveSpeed);
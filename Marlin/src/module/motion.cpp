@@ -71,6 +71,10 @@
   #include "../feature/babystep.h"
 #endif
 
+#if ENABLED(SEGMENT_COALESCING)
+  #include "../feature/segment_coalescer.h"
+#endif
+
 #define DEBUG_OUT ENABLED(DEBUG_LEVELING_FEATURE)
 #include "../core/debug_out.h"
 
@@ -921,7 +925,7 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
       }
     #endif // HAS_MESH
 
-    planner.buffer_line(destination, scaled_fr_mm_s, active_extruder);
+    TERN(SEGMENT_COALESCING, coalescer.line_to, planner.buffer_line)(destination, scaled_fr_mm_s, active_extruder);
     return false; // caller will update current_position
   }
 
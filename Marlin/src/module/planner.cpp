@@ -115,6 +115,10 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(SEGMENT_COALESCING)
+  #include "../feature/segment_coalescer.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
@@ -127,13 +131,19 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
-                 Planner::block_buffer_nonbusy, // Index of the first non-busy block
-                 Planner::block_buffer_planned, // Index of the optimally planned block
-                 Planner::block_buffer_tail;    // Index of the busy block, if any
+volatile block_index_t Planner::block_buffer_head,    // Index of the next block to be pushed
+                       Planner::block_buffer_nonbusy, // Index of the first non-busy block
+                       Planner::block_buffer_planned, // Index of the optimally planned block
+                       Planner::block_buffer_tail;    // Index of the busy block, if any
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+#if ENABLED(PLANNER_FIXED_POINT_CHECK)
+  uint32_t Planner::fixed_point_checks; // = 0
+  trapezoid_t Planner::fixed_point_error; // = { 0 }
+  uint64_t Planner::fixed_point_cycles, Planner::float_cycles; // = 0
+#endif
+
 planner_settings_t Planner::settings;           // Initialized by settings.load()
 
 #if ENABLED(LASER_POWER_INLINE)
@@ -217,7 +227,11 @@ xyze_float_t Planner::previous_speed;
 float Planner::previous_nominal_speed_sqr;
 
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
-  uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  block_index_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+#endif
+
+#if ENABLED(ARC_BLOCKS)
+  const arc_t *Planner::arc_move; // = nullptr
 #endif
 
 #ifdef XY_FREQUENCY_LIMIT
@@ -261,6 +275,9 @@ void Planner::init() {
     last_page_step_rate = 0;
     last_page_dir.reset();
   #endif
+  #if BOTH(PLANNER_FIXED_POINT_CHECK, HAL_CYCLE_COUNTER)
+    HAL_cycle_counter_init();
+  #endif
 }
 
 #if ENABLED(S_CURVE_ACCELERATION)
@@ -730,7 +747,7 @@ void Planner::init() {
  */
 block_t* Planner::get_current_block() {
   // Get the number of moves in the planner queue so far
-  const uint8_t nr_moves = movesplanned();
+  const block_index_t nr_moves = movesplanned();
 
   // If there are any moves queued ...
   if (nr_moves) {
@@ -770,17 +787,8 @@ block_t* Planner::get_current_block() {
   return nullptr;
 }
 
-/**
- * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
- * by the provided factors.
- **
- * ############ VERY IMPORTANT ############
- * NOTE that the PRECONDITION to call this function is that the block is
- * NOT BUSY and it is marked as RECALCULATE. That WARRANTIES the Stepper ISR
- * is not and will not use the block while we modify it, so it is safe to
- * alter its values.
- */
-void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
+// Trapezoid math using float
+void Planner::trapezoid_float(const block_t * const block, const float &entry_factor, const float &exit_factor, trapezoid_t &t) {
 
   uint32_t initial_rate = CEIL(block->nominal_rate * entry_factor),
            final_rate = CEIL(block->nominal_rate * exit_factor); // (steps per second)
@@ -820,27 +828,159 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
       cruise_rate = block->nominal_rate;
   #endif
 
+  t.initial_rate = initial_rate;
+  t.final_rate = final_rate;
+  t.accelerate_steps = accelerate_steps;
+  t.plateau_steps = plateau_steps;
+
   #if ENABLED(S_CURVE_ACCELERATION)
     // Jerk controlled speed requires to express speed versus time, NOT steps
-    uint32_t acceleration_time = ((float)(cruise_rate - initial_rate) / accel) * (STEPPER_TIMER_RATE),
-             deceleration_time = ((float)(cruise_rate - final_rate) / accel) * (STEPPER_TIMER_RATE),
-    // And to offload calculations from the ISR, we also calculate the inverse of those times here
-             acceleration_time_inverse = get_period_inverse(acceleration_time),
-             deceleration_time_inverse = get_period_inverse(deceleration_time);
+    t.acceleration_time = ((float)(cruise_rate - initial_rate) / accel) * (STEPPER_TIMER_RATE);
+    t.deceleration_time = ((float)(cruise_rate - final_rate) / accel) * (STEPPER_TIMER_RATE);
+    t.cruise_rate = cruise_rate;
+  #endif
+}
+
+#if ENABLED(PLANNER_FIXED_POINT)
+
+  // Entry and exit factors in Q8.24 fixed-point
+  #define TRAPEZOID_FACTOR_BITS 24
+
+  // Integer square root, rounded down
+  static uint32_t isqrt64(uint64_t v) {
+    if (!v) return 0;
+    uint64_t r = 0, bit = 1ULL << ((63 - __builtin_clzll(v)) & ~1);
+    while (bit) {
+      if (v >= r + bit) { v -= r + bit; r = (r >> 1) + bit; }
+      else r >>= 1;
+      bit >>= 2;
+    }
+    return r;
+  }
+
+  // Divide with a 32-bit (hardware on Cortex-M3) division when the operands fit
+  FORCE_INLINE static uint32_t udiv64(const uint64_t n, const uint64_t d) {
+    return ((n | d) >> 32) ? uint32_t(n / d) : uint32_t(n) / uint32_t(d);
+  }
+
+  /**
+   * Trapezoid math using only integers. Step rates and accelerations are already
+   * integer, so the squares and quotients are exact in 64 bits. The results match
+   * trapezoid_float() to within float rounding, usually exactly.
+   */
+  void Planner::trapezoid_fixed(const block_t * const block, const float &entry_factor, const float &exit_factor, trapezoid_t &t) {
+    const uint32_t nominal_rate = block->nominal_rate,
+                   step_event_count = block->step_event_count,
+                   accel = block->acceleration_steps_per_s2;
+
+    // Rates rounded up, limited to the minimal step rate
+    constexpr float factor_scale = float(1UL << TRAPEZOID_FACTOR_BITS);
+    constexpr uint64_t factor_round = (1UL << TRAPEZOID_FACTOR_BITS) - 1;
+    const uint32_t initial_rate = _MAX(uint32_t((uint64_t(nominal_rate) * uint32_t(entry_factor * factor_scale) + factor_round) >> TRAPEZOID_FACTOR_BITS), uint32_t(MINIMAL_STEP_RATE)),
+                   final_rate = _MAX(uint32_t((uint64_t(nominal_rate) * uint32_t(exit_factor * factor_scale) + factor_round) >> TRAPEZOID_FACTOR_BITS), uint32_t(MINIMAL_STEP_RATE));
+
+    const uint64_t nominal_sqr = sq(uint64_t(nominal_rate)),
+                   initial_sqr = sq(uint64_t(initial_rate)),
+                   final_sqr = sq(uint64_t(final_rate)),
+                   accel2 = uint64_t(accel) * 2;
+
+    // Steps required for acceleration (rounded up), deceleration (rounded down) to/from nominal rate
+    uint32_t accelerate_steps = 0, decelerate_steps = 0;
+    if (accel) {
+      if (nominal_sqr > initial_sqr) accelerate_steps = udiv64(nominal_sqr - initial_sqr + accel2 - 1, accel2);
+      if (nominal_sqr > final_sqr) decelerate_steps = udiv64(nominal_sqr - final_sqr, accel2);
+    }
+    int32_t plateau_steps = step_event_count - accelerate_steps - decelerate_steps;
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      uint32_t cruise_rate = nominal_rate;
+    #endif
+
+    // No cruising: accelerate to the point where braking reaches final_rate at the end
+    if (plateau_steps < 0) {
+      const int64_t dist = int64_t(accel2 * step_event_count + final_sqr) - int64_t(initial_sqr);
+      accelerate_steps = (accel && dist > 0) ? _MIN(udiv64(dist + accel2 * 2 - 1, accel2 * 2), step_event_count) : 0;
+      plateau_steps = 0;
+      #if ENABLED(S_CURVE_ACCELERATION)
+        cruise_rate = isqrt64(initial_sqr + accel2 * accelerate_steps);
+      #endif
+    }
+
+    t.initial_rate = initial_rate;
+    t.final_rate = final_rate;
+    t.accelerate_steps = accelerate_steps;
+    t.plateau_steps = plateau_steps;
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      t.acceleration_time = (accel && cruise_rate > initial_rate) ? udiv64(uint64_t(cruise_rate - initial_rate) * (STEPPER_TIMER_RATE), accel) : 0;
+      t.deceleration_time = (accel && cruise_rate > final_rate) ? udiv64(uint64_t(cruise_rate - final_rate) * (STEPPER_TIMER_RATE), accel) : 0;
+      t.cruise_rate = cruise_rate;
+    #endif
+  }
+
+#endif // PLANNER_FIXED_POINT
+
+/**
+ * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
+ * by the provided factors.
+ **
+ * ############ VERY IMPORTANT ############
+ * NOTE that the PRECONDITION to call this function is that the block is
+ * NOT BUSY and it is marked as RECALCULATE. That WARRANTIES the Stepper ISR
+ * is not and will not use the block while we modify it, so it is safe to
+ * alter its values.
+ */
+void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
+
+  trapezoid_t t;
+
+  #if ENABLED(PLANNER_FIXED_POINT_CHECK)
+    // Run both and keep the largest difference
+    trapezoid_t f;
+    #ifdef HAL_CYCLE_COUNTER
+      const uint32_t c0 = HAL_cycle_count();
+      trapezoid_fixed(block, entry_factor, exit_factor, t);
+      const uint32_t c1 = HAL_cycle_count();
+      trapezoid_float(block, entry_factor, exit_factor, f);
+      fixed_point_cycles += c1 - c0;
+      float_cycles += HAL_cycle_count() - c1;
+    #else
+      trapezoid_fixed(block, entry_factor, exit_factor, t);
+      trapezoid_float(block, entry_factor, exit_factor, f);
+    #endif
+    fixed_point_checks++;
+    #define _TRAP_ERR(F) NOLESS(fixed_point_error.F, uint32_t(ABS(int32_t(t.F - f.F))))
+    _TRAP_ERR(initial_rate);
+    _TRAP_ERR(final_rate);
+    _TRAP_ERR(accelerate_steps);
+    _TRAP_ERR(plateau_steps);
+    #if ENABLED(S_CURVE_ACCELERATION)
+      _TRAP_ERR(cruise_rate);
+      _TRAP_ERR(acceleration_time);
+      _TRAP_ERR(deceleration_time);
+    #endif
+    #undef _TRAP_ERR
+  #elif ENABLED(PLANNER_FIXED_POINT)
+    trapezoid_fixed(block, entry_factor, exit_factor, t);
+  #else
+    trapezoid_float(block, entry_factor, exit_factor, t);
   #endif
 
+  const uint32_t accelerate_steps = t.accelerate_steps;
+
   // Store new block parameters
   block->accelerate_until = accelerate_steps;
-  block->decelerate_after = accelerate_steps + plateau_steps;
-  block->initial_rate = initial_rate;
+  block->decelerate_after = accelerate_steps + t.plateau_steps;
+  block->initial_rate = t.initial_rate;
   #if ENABLED(S_CURVE_ACCELERATION)
-    block->acceleration_time = acceleration_time;
-    block->deceleration_time = deceleration_time;
-    block->acceleration_time_inverse = acceleration_time_inverse;
-    block->deceleration_time_inverse = deceleration_time_inverse;
-    block->cruise_rate = cruise_rate;
+    block->acceleration_time = t.acceleration_time;
+    block->deceleration_time = t.deceleration_time;
+    // And to offload calculations from the ISR, we also calculate the inverse of those times here
+    block->acceleration_time_inverse = get_period_inverse(t.acceleration_time);
+    block->deceleration_time_inverse = get_period_inverse(t.deceleration_time);
+    block->cruise_rate = t.cruise_rate;
   #endif
-  block->final_rate = final_rate;
+  block->final_rate = t.final_rate;
 
   /**
    * Laser trapezoid calculations
@@ -1000,22 +1140,25 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
  */
 void Planner::reverse_pass() {
   // Initialize block index to the last block in the planner buffer.
-  uint8_t block_index = prev_block_index(block_buffer_head);
+  block_index_t block_index = prev_block_index(block_buffer_head);
 
   // Read the index of the last buffer planned block.
   // The ISR may change it so get a stable local copy.
-  uint8_t planned_block_index = block_buffer_planned;
+  block_index_t planned_block_index = block_buffer_planned;
 
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
   //  planning already consumed blocks
   if (planned_block_index == block_buffer_head) return;
 
+  // Don't look further back than the planning window
+  const block_index_t window_block_index = window_start(planned_block_index);
+
   // Reverse Pass: Coarsely maximize all possible deceleration curves back-planning from the last
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
   // NOTE: Forward pass will later refine and correct the reverse pass to create an optimal plan.
   const block_t *next = nullptr;
-  while (block_index != planned_block_index) {
+  while (block_index != planned_block_index && block_index != window_block_index) {
 
     // Perform the reverse pass
     block_t *current = &block_buffer[block_index];
@@ -1044,7 +1187,7 @@ void Planner::reverse_pass() {
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
-void Planner::forward_pass_kernel(const block_t* const previous, block_t* const current, const uint8_t block_index) {
+void Planner::forward_pass_kernel(const block_t* const previous, block_t* const current, const block_index_t block_index) {
   if (previous) {
     // If the previous block is an acceleration block, too short to complete the full speed
     // change, adjust the entry speed accordingly. Entry speeds have already been reset,
@@ -1105,8 +1248,9 @@ void Planner::forward_pass() {
   // Begin at buffer planned pointer. Note that block_buffer_planned can be modified
   //  by the stepper ISR,  so read it ONCE. It it guaranteed that block_buffer_planned
   //  will never lead head, so the loop is safe to execute. Also note that the forward
-  //  pass will never modify the values at the tail.
-  uint8_t block_index = block_buffer_planned;
+  //  pass will never modify the values at the tail. Start no earlier than the planning
+  //  window, whose first block is left unchanged by the reverse pass.
+  block_index_t block_index = window_start(block_buffer_planned);
 
   block_t *block;
   const block_t * previous = nullptr;
@@ -1138,15 +1282,16 @@ void Planner::forward_pass() {
  */
 void Planner::recalculate_trapezoids() {
   // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
-          head_block_index = block_buffer_head;
+  // Blocks before the planning window haven't changed.
+  block_index_t block_index = window_start(block_buffer_tail),
+                head_block_index = block_buffer_head;
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
   while (head_block_index != block_index) {
 
     // Go back (head always point to the first free block)
-    const uint8_t prev_index = prev_block_index(head_block_index);
+    const block_index_t prev_index = prev_block_index(head_block_index);
 
     // Get the pointer to the block
     block_t *prev = &block_buffer[prev_index];
@@ -1244,7 +1389,7 @@ void Planner::recalculate_trapezoids() {
 
 void Planner::recalculate() {
   // Initialize block index to the last block in the planner buffer.
-  const uint8_t block_index = prev_block_index(block_buffer_head);
+  const block_index_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
   if (block_index != block_buffer_planned) {
     reverse_pass();
@@ -1262,7 +1407,7 @@ void Planner::recalculate() {
     if (thermalManager.degTargetHotend(0) + 2 < autotemp_min) return; // probably temperature set to zero.
 
     float high = 0.0;
-    for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+    for (block_index_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block_t* block = &block_buffer[b];
       if (block->steps.x || block->steps.y || block->steps.z) {
         const float se = (float)block->steps.e / block->step_event_count * SQRT(block->nominal_speed_sqr); // mm/sec;
@@ -1318,7 +1463,7 @@ void Planner::check_axes_activity() {
     #endif
 
     #if ANY(DISABLE_X, DISABLE_Y, DISABLE_Z, DISABLE_E)
-      for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+      for (block_index_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
         block_t *block = &block_buffer[b];
         if (ENABLED(DISABLE_X) && block->steps.x) axis_active.x = true;
         if (ENABLED(DISABLE_Y) && block->steps.y) axis_active.y = true;
@@ -1575,7 +1720,8 @@ void Planner::quick_stop() {
 
   const bool was_enabled = stepper.suspend();
 
-  // Drop all queue entries
+  // Drop a held segment and all queue entries
+  TERN_(SEGMENT_COALESCING, coalescer.discard());
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
   // Restart the block delay for the first movement - As the queue was
@@ -1645,8 +1791,10 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
  * Block until all buffered steps are executed / cleaned
  */
 void Planner::synchronize() {
+  TERN_(SEGMENT_COALESCING, coalescer.flush());
   while (has_blocks_queued() || cleaning_buffer_counter
       || TERN0(EXTERNAL_CLOSED_LOOP_CONTROLLER, CLOSED_LOOP_WAITING())
+      || TERN0(INPUT_SHAPING, stepper.shaping_busy())
   ) idle();
 }
 
@@ -1677,7 +1825,7 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   if (cleaning_buffer_counter) return false;
 
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // Fill the block with the specified movement
@@ -1940,9 +2088,29 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   block->step_event_count = _MAX(block->steps.a, block->steps.b, block->steps.c, esteps);
 
+  #if ENABLED(ARC_BLOCKS)
+    // One step event per X or Y step length along the arc, so X and Y never need two steps in one event
+    if (arc_move) NOLESS(block->step_event_count, uint32_t(CEIL(arc_move->length * _MAX(settings.axis_steps_per_mm[X_AXIS], settings.axis_steps_per_mm[Y_AXIS]))));
+  #endif
+
   // Bail if this is a zero-length block
   if (block->step_event_count < MIN_STEPS_PER_SEGMENT) return false;
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc_move) {
+      block->flag |= BLOCK_FLAG_ARC;
+      constexpr float unit = float(1UL << ARC_UNIT_BITS), radius_unit = float(1UL << ARC_RADIUS_BITS);
+      const float theta_d = arc_move->angular_travel / block->step_event_count,
+                  half_sin = sin(theta_d * 0.5f);
+      block->arc.cos_0 = LROUND(cos(arc_move->start_angle) * unit);
+      block->arc.sin_0 = LROUND(sin(arc_move->start_angle) * unit);
+      block->arc.cos_d = (1L << ARC_UNIT_BITS) - LROUND(2 * sq(half_sin) * unit); // 1 - 2sin²(θ/2) keeps the precision of tiny angles
+      block->arc.sin_d = LROUND(sin(theta_d) * unit);
+      block->arc.radius_x = LROUND(arc_move->radius * settings.axis_steps_per_mm[X_AXIS] * radius_unit);
+      block->arc.radius_y = LROUND(arc_move->radius * settings.axis_steps_per_mm[Y_AXIS] * radius_unit);
+    }
+  #endif
+
   #if ENABLED(MIXING_EXTRUDER)
     MIXER_POPULATE_BLOCK();
   #endif
@@ -2044,7 +2212,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   float inverse_secs = fr_mm_s * inverse_millimeters;
 
   // Get the number of non busy movements in queue (non busy means that they can be altered)
-  const uint8_t moves_queued = nonbusy_movesplanned();
+  const block_index_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
   #if EITHER(SLOWDOWN, HAS_SPI_LCD) || defined(XY_FREQUENCY_LIMIT)
@@ -2100,6 +2268,17 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     if (cs > max_fr) NOMORE(speed_factor, max_fr / cs);
   }
 
+  #if ENABLED(ARC_BLOCKS)
+    // Along an arc X and Y go fastest where the tangent is closest to each axis
+    if (arc_move) {
+      const float xy_speed = arc_move->length * inverse_secs;
+      current_speed.set(xy_speed * _MAX(ABS(arc_move->entry.x), ABS(arc_move->exit.x)),
+                        xy_speed * _MAX(ABS(arc_move->entry.y), ABS(arc_move->exit.y)));
+      if (current_speed.x > settings.max_feedrate_mm_s[X_AXIS]) NOMORE(speed_factor, settings.max_feedrate_mm_s[X_AXIS] / current_speed.x);
+      if (current_speed.y > settings.max_feedrate_mm_s[Y_AXIS]) NOMORE(speed_factor, settings.max_feedrate_mm_s[Y_AXIS] / current_speed.y);
+    }
+  #endif
+
   // Limit speed on extruders, if any
   #if EXTRUDERS
     {
@@ -2227,9 +2406,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
           #if IS_KINEMATIC
             block->millimeters
           #else
+            (TERN0(ARC_BLOCKS, arc_move) ? block->millimeters :
             SQRT(sq(target_float.x - position_float.x)
                + sq(target_float.y - position_float.y)
-               + sq(target_float.z - position_float.z))
+               + sq(target_float.z - position_float.z)))
           #endif
         ;
 
@@ -2259,12 +2439,33 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       LIMIT_ACCEL_FLOAT(C_AXIS, 0);
       LIMIT_ACCEL_FLOAT(E_AXIS, E_INDEX_N(extruder));
     }
+
+    #if ENABLED(ARC_BLOCKS)
+      // Somewhere along an arc X or Y takes all of the acceleration
+      if (arc_move) NOMORE(accel, uint32_t(_MIN(settings.max_acceleration_mm_per_s2[X_AXIS], settings.max_acceleration_mm_per_s2[Y_AXIS]) * steps_per_mm));
+    #endif
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (STEPPER_TIMER_RATE)));
   #endif
+
+  #if ENABLED(ARC_BLOCKS)
+    if (arc_move) {
+      // Keep the centripetal acceleration (XY speed)² / radius within the block acceleration
+      const float max_speed_sqr = block->acceleration * arc_move->radius * sq(block->millimeters / arc_move->length);
+      if (block->nominal_speed_sqr > max_speed_sqr) {
+        const float factor = SQRT(max_speed_sqr / block->nominal_speed_sqr);
+        block->nominal_speed_sqr = max_speed_sqr;
+        block->nominal_rate = CEIL(block->nominal_rate * factor);
+      }
+
+      // At the junctions X and Y move along the tangents
+      const float xy_speed = SQRT(block->nominal_speed_sqr) * arc_move->length / block->millimeters;
+      current_speed.set(arc_move->entry.x * xy_speed, arc_move->entry.y * xy_speed);
+    }
+  #endif
   #if ENABLED(LIN_ADVANCE)
     if (block->use_advance_lead) {
       block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
@@ -2325,6 +2526,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       #endif
     ;
 
+    // An arc starts out along its entry tangent
+    TERN_(ARC_BLOCKS, if (arc_move) unit_vec.set(arc_move->entry.x * arc_move->length, arc_move->entry.y * arc_move->length));
+
     /**
      * On CoreXY the length of the vector [A,B] is SQRT(2) times the length of the head movement vector [X,Y].
      * So taking Z and E into account, we cannot scale to a unit vector with "inverse_millimeters".
@@ -2457,6 +2661,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
     prev_unit_vec = unit_vec;
 
+    #if ENABLED(ARC_BLOCKS)
+      // ...and ends along its exit tangent
+      if (arc_move) {
+        const float xy = HYPOT(unit_vec.x, unit_vec.y);
+        prev_unit_vec.set(arc_move->exit.x * xy, arc_move->exit.y * xy);
+      }
+    #endif
+
   #endif
 
   #ifdef USE_CACHED_SQRT
@@ -2590,6 +2802,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   // Update previous path unit_vector and nominal speed
   previous_speed = current_speed;
+  #if ENABLED(ARC_BLOCKS)
+    if (arc_move) {
+      const float xy_speed = SQRT(block->nominal_speed_sqr) * arc_move->length / block->millimeters;
+      previous_speed.set(arc_move->exit.x * xy_speed, arc_move->exit.y * xy_speed);
+    }
+  #endif
   previous_nominal_speed_sqr = block->nominal_speed_sqr;
 #if ENABLED(DOGM_SHOW_SPEED)
   dogmSpeedToShow = int16_t(0.5 + SQRT(block->nominal_speed_sqr));
@@ -2611,7 +2829,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
  */
 void Planner::buffer_sync_block() {
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // Clear block
@@ -2657,6 +2875,9 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
   , const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
 ) {
 
+  // Moves that bypass the coalescer go after the held segment
+  TERN_(SEGMENT_COALESCING, coalescer.flush());
+
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
@@ -2795,6 +3016,35 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
   #endif
 } // buffer_line()
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Add an arc in the XY plane that doesn't cross the X or Y axis through its center.
+   * The arc goes through the same checks and limits as a line to 'cart', with the
+   * arc geometry added by _populate_block.
+   */
+  bool Planner::buffer_arc(const xyze_pos_t &cart, const float &radius, const float &start_angle, const float &angular_travel,
+                           const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters
+  ) {
+    // A held line must still go as a line
+    TERN_(SEGMENT_COALESCING, coalescer.flush());
+
+    const float end_angle = start_angle + angular_travel,
+                dir = angular_travel < 0 ? -1 : 1;
+    const arc_t arc = {
+      radius, start_angle, angular_travel, radius * ABS(angular_travel),
+      { -dir * sin(start_angle), dir * cos(start_angle) },
+      { -dir * sin(end_angle), dir * cos(end_angle) }
+    };
+
+    arc_move = &arc;
+    const bool queued = buffer_line(cart, fr_mm_s, extruder, millimeters);
+    arc_move = nullptr;
+    return queued;
+  }
+
+#endif // ARC_BLOCKS
+
 #if ENABLED(DIRECT_STEPPING)
 
   void Planner::buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps) {
@@ -2803,7 +3053,7 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
       return;
     }
 
-    uint8_t next_buffer_head;
+    block_index_t next_buffer_head;
     block_t * const block = get_next_free_block(next_buffer_head);
 
     block->flag = BLOCK_FLAG_IS_PAGE;
@@ -2866,6 +3116,7 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
  */
 
 void Planner::set_machine_position_mm(const float &a, const float &b, const float &c, const float &e) {
+  TERN_(SEGMENT_COALESCING, coalescer.flush());
   TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
   TERN_(HAS_POSITION_FLOAT, position_float.set(a, b, c, e));
   position.set(LROUND(a * settings.axis_steps_per_mm[A_AXIS]),
@@ -2899,6 +3150,7 @@ void Planner::set_position_mm(const float &rx, const float &ry, const float &rz,
  * Setters for planner position (also setting stepper position).
  */
 void Planner::set_e_position_mm(const float &e) {
+  TERN_(SEGMENT_COALESCING, coalescer.flush());
   const uint8_t axis_index = E_AXIS_N(active_extruder);
   TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
 
@@ -73,6 +73,12 @@
   #define IS_PAGE(B) false
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+  #define IS_ARC(B) TEST(B->flag, BLOCK_BIT_ARC)
+#else
+  #define IS_ARC(B) false
+#endif
+
 // Feedrate for manual moves
 #ifdef MANUAL_FEEDRATE
   constexpr xyze_feedrate_t _mf = MANUAL_FEEDRATE,
@@ -102,6 +108,11 @@ enum BlockFlagBit : char {
   #if ENABLED(DIRECT_STEPPING)
     , BLOCK_BIT_IS_PAGE
   #endif
+
+  // X and Y follow an arc (See block_t::arc)
+  #if ENABLED(ARC_BLOCKS)
+    , BLOCK_BIT_ARC
+  #endif
 };
 
 enum BlockFlag : char {
@@ -112,8 +123,39 @@ enum BlockFlag : char {
   #if ENABLED(DIRECT_STEPPING)
     , BLOCK_FLAG_IS_PAGE            = _BV(BLOCK_BIT_IS_PAGE)
   #endif
+  #if ENABLED(ARC_BLOCKS)
+    , BLOCK_FLAG_ARC                = _BV(BLOCK_BIT_ARC)
+  #endif
 };
 
+#if ENABLED(ARC_BLOCKS)
+
+  #define ARC_UNIT_BITS   30  // Unit vectors are Q2.30
+  #define ARC_RADIUS_BITS  8  // Radii are Q24.8 steps
+
+  /**
+   * An arc in step units, for the Stepper to follow one step event at a time.
+   * The direction from the center starts at (cos_0, sin_0) and is rotated by
+   * (cos_d, sin_d) on each step event. X and Y are at the radius times the
+   * change in cos and sin, rounded to whole steps.
+   */
+  typedef struct {
+    int32_t cos_0, sin_0,                   // Direction from the center to the start point
+            cos_d, sin_d,                   // Rotation per step event. sin_d < 0 for clockwise.
+            radius_x, radius_y;             // Radius in X and Y steps
+  } arc_steps_t;
+
+  // An arc as given to Planner::buffer_arc
+  typedef struct {
+    float radius,                           // (mm)
+          start_angle,                      // (rad) Direction from the center to the start point
+          angular_travel,                   // (rad) Positive is counter-clockwise
+          length;                           // (mm) Length in the XY plane
+    xy_float_t entry, exit;                 // Unit tangents at both ends
+  } arc_t;
+
+#endif
+
 #if ENABLED(LASER_POWER_INLINE)
 
   typedef struct {
@@ -230,14 +272,31 @@ typedef struct block_t {
     block_laser_t laser;
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    arc_steps_t arc;                        // Arc followed by X and Y (BLOCK_BIT_ARC)
+  #endif
+
 } block_t;
 
+// The acceleration profile of a block, before it's stored in the block
+typedef struct {
+  uint32_t initial_rate, final_rate,          // (steps/s)
+           accelerate_steps, plateau_steps;
+  #if ENABLED(S_CURVE_ACCELERATION)
+    uint32_t cruise_rate,                     // (steps/s)
+             acceleration_time, deceleration_time; // (timer ticks)
+  #endif
+} trapezoid_t;
+
 #if ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
   #define HAS_POSITION_FLOAT 1
 #endif
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+// Index of a block in the ring buffer. Deep buffers need 16 bits.
+typedef IF<(BLOCK_BUFFER_SIZE > 64), uint16_t, uint8_t>::type block_index_t;
+
 #if ENABLED(LASER_POWER_INLINE)
   typedef struct {
     /**
@@ -304,13 +363,20 @@ class Planner {
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
-    static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
-                            block_buffer_nonbusy,   // Index of the first non busy block
-                            block_buffer_planned,   // Index of the optimally planned block
-                            block_buffer_tail;      // Index of the busy block, if any
+    static volatile block_index_t block_buffer_head,    // Index of the next block to be pushed
+                                  block_buffer_nonbusy, // Index of the first non busy block
+                                  block_buffer_planned, // Index of the optimally planned block
+                                  block_buffer_tail;    // Index of the busy block, if any
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+    #if ENABLED(PLANNER_FIXED_POINT_CHECK)
+      static uint32_t fixed_point_checks;           // Trapezoids computed with both float and fixed-point math
+      static trapezoid_t fixed_point_error;         // Largest difference per field
+      static uint64_t fixed_point_cycles,           // Total cycles spent by each method
+                      float_cycles;
+    #endif
+
 
     #if ENABLED(DISTINCT_E_FACTORS)
       static uint8_t last_extruder;                 // Respond to extruder change
@@ -435,7 +501,11 @@ class Planner {
 
     #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
        // Counters to manage disabling inactive extruders
-      static uint8_t g_uc_extruder_last_move[EXTRUDERS];
+      static block_index_t g_uc_extruder_last_move[EXTRUDERS];
+    #endif
+
+    #if ENABLED(ARC_BLOCKS)
+      static const arc_t *arc_move;       // The arc being added by buffer_arc(), or nullptr
     #endif
 
     #if HAS_SPI_LCD
@@ -622,10 +692,10 @@ class Planner {
     #endif // HAS_POSITION_MODIFIERS
 
     // Number of moves currently in the planner including the busy block, if any
-    FORCE_INLINE static uint8_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
+    FORCE_INLINE static block_index_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
 
     // Number of nonbusy moves currently in the planner
-    FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
+    FORCE_INLINE static block_index_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
 
     // Remove all blocks from the buffer
     FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
@@ -634,7 +704,7 @@ class Planner {
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
 
     // Get count of movement slots free
-    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
+    FORCE_INLINE static block_index_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
 
     /**
      * Planner::get_next_free_block
@@ -643,7 +713,7 @@ class Planner {
      * - Wait for the number of spaces to open up in the planner
      * - Return the first head block
      */
-    FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
+    FORCE_INLINE static block_t* get_next_free_block(block_index_t &next_buffer_head, const uint8_t count=1) {
 
       // Wait until there are enough slots free
       while (moves_free() < count) { idle(); }
@@ -774,6 +844,24 @@ class Planner {
       );
     }
 
+    #if ENABLED(ARC_BLOCKS)
+      /**
+       * Add an arc in the XY plane, ending at 'cart', that the Stepper follows
+       * along the curve. The arc must not cross the X or Y axis through its
+       * center, so X and Y each move in one direction.
+       *
+       *  cart           - target position in mm
+       *  radius         - radius in mm
+       *  start_angle    - direction from the center to the current position
+       *  angular_travel - angle to travel, positive for counter-clockwise
+       *  fr_mm_s        - (target) speed of the move (mm/s)
+       *  extruder       - target extruder
+       *  millimeters    - the length of the movement, including Z
+       */
+      static bool buffer_arc(const xyze_pos_t &cart, const float &radius, const float &start_angle, const float &angular_travel,
+                             const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters);
+    #endif
+
     #if ENABLED(DIRECT_STEPPING)
       static void buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps);
     #endif
@@ -897,8 +985,8 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    static constexpr block_index_t next_block_index(const block_index_t block_index) { return BLOCK_MOD(block_index + 1); }
+    static constexpr block_index_t prev_block_index(const block_index_t block_index) { return BLOCK_MOD(block_index - 1); }
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -940,10 +1028,27 @@ class Planner {
       }
     #endif
 
+    static void trapezoid_float(const block_t * const block, const float &entry_factor, const float &exit_factor, trapezoid_t &t);
+    #if ENABLED(PLANNER_FIXED_POINT)
+      static void trapezoid_fixed(const block_t * const block, const float &entry_factor, const float &exit_factor, trapezoid_t &t);
+    #endif
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
 
     static void reverse_pass_kernel(block_t* const current, const block_t * const next);
-    static void forward_pass_kernel(const block_t * const previous, block_t* const current, uint8_t block_index);
+    static void forward_pass_kernel(const block_t * const previous, block_t* const current, const block_index_t block_index);
+
+    /**
+     * The oldest block that replanning may change, given the oldest block it could start from.
+     * With PLANNER_WINDOW_SIZE only the newest blocks are replanned, so the cost of adding
+     * a block doesn't grow with the buffer. Older blocks keep their (lower, safe) speeds.
+     */
+    FORCE_INLINE static block_index_t window_start(const block_index_t block_index) {
+      #ifdef PLANNER_WINDOW_SIZE
+        if (BLOCK_MOD(block_buffer_head - block_index) > (PLANNER_WINDOW_SIZE))
+          return BLOCK_MOD(block_buffer_head - (PLANNER_WINDOW_SIZE));
+      #endif
+      return block_index;
+    }
 
     static void reverse_pass();
     static void forward_pass();
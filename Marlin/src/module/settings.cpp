@@ -37,7 +37,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V81"
+#define EEPROM_VERSION "V82"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -124,6 +124,10 @@
   void M217_report(const bool eeprom);
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  void M593_report(const bool forReplay);
+#endif
+
 #if ENABLED(BLTOUCH)
   #include "../feature/bltouch.h"
 #endif
@@ -418,6 +422,13 @@ typedef struct SettingsDataStruct {
     uint8_t caselight_brightness;                        // M355 P
   #endif
 
+  //
+  // INPUT_SHAPING
+  //
+  #if ENABLED(INPUT_SHAPING)
+    shaping_settings_t shaping_settings[2];             // M593 X Y F D T
+  #endif
+
   //
   // PASSWORD_FEATURE
   //
@@ -486,6 +497,8 @@ void MarlinSettings::postprocess() {
 
   TERN_(HAS_CASE_LIGHT_BRIGHTNESS, caselight.update_brightness());
 
+  TERN_(INPUT_SHAPING, stepper.apply_shaping());
+
   // Refresh steps_to_mm with the reciprocal of axis_steps_per_mm
   // and init stepper.count[], planner.position[] with current_position
   planner.refresh_positioning();
@@ -1383,6 +1396,15 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(caselight.brightness);
     #endif
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      _FIELD_TEST(shaping_settings);
+      EEPROM_WRITE(stepper.shaper[X_AXIS].settings);
+      EEPROM_WRITE(stepper.shaper[Y_AXIS].settings);
+    #endif
+
     //
     // Password feature
     //
@@ -2247,6 +2269,15 @@ void MarlinSettings::postprocess() {
         EEPROM_READ(caselight.brightness);
       #endif
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING)
+        _FIELD_TEST(shaping_settings);
+        EEPROM_READ(stepper.shaper[X_AXIS].settings);
+        EEPROM_READ(stepper.shaper[Y_AXIS].settings);
+      #endif
+
       //
       // Password feature
       //
@@ -2577,6 +2608,14 @@ void MarlinSettings::reset() {
   //
   TERN_(HAS_CASE_LIGHT_BRIGHTNESS, caselight.brightness = CASE_LIGHT_DEFAULT_BRIGHTNESS);
 
+  //
+  // Input Shaping
+  //
+  #if ENABLED(INPUT_SHAPING)
+    stepper.shaper[X_AXIS].settings = { SHAPING_TYPE, SHAPING_FREQ_X, SHAPING_ZETA_X };
+    stepper.shaper[Y_AXIS].settings = { SHAPING_TYPE, SHAPING_FREQ_Y, SHAPING_ZETA_Y };
+  #endif
+
   //
   // TOUCH_SCREEN_CALIBRATION
   //
@@ -3738,6 +3777,11 @@ void MarlinSettings::reset() {
       #endif
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      CONFIG_ECHO_HEADING("Input Shaping:");
+      M593_report(forReplay);
+    #endif
+
     #if HAS_MOTOR_CURRENT_PWM
       CONFIG_ECHO_HEADING("Stepper motor currents:");
       CONFIG_ECHO_START();
@@ -136,6 +136,22 @@ Stepper stepper; // Singleton
   #include "../feature/spindle_laser.h"
 #endif
 
+// Shaped axes have their direction set by the shaper
+#if ENABLED(INPUT_SHAPING)
+  #define X_SHAPED shaper[X_AXIS].enabled
+  #define Y_SHAPED shaper[Y_AXIS].enabled
+#else
+  #define X_SHAPED false
+  #define Y_SHAPED false
+#endif
+#define Z_SHAPED false
+
+#if ENABLED(STEPPER_ISR_PROFILER)
+  #include "../feature/stepper_profiler.h"
+#else
+  #define PROFILE_STEPPER_PHASE(P) NOOP
+#endif
+
 // public:
 
 #if EITHER(HAS_EXTRA_ENDSTOPS, Z_STEPPER_AUTO_ALIGN)
@@ -184,6 +200,12 @@ TERN(ADAPTIVE_STEP_SMOOTHING,,constexpr) uint8_t Stepper::oversampling_factor;
 
 xyze_long_t Stepper::delta_error{0};
 
+#if ENABLED(ARC_BLOCKS)
+  int32_t Stepper::arc_cos, Stepper::arc_sin;
+  xy_ulong_t Stepper::arc_done;
+  uint32_t Stepper::arc_events_left;
+#endif
+
 xyze_ulong_t Stepper::advance_dividend{0};
 uint32_t Stepper::advance_divisor = 0,
          Stepper::step_events_completed = 0, // The number of step events executed in the current block
@@ -231,6 +253,12 @@ uint32_t Stepper::advance_divisor = 0,
   page_step_state_t Stepper::page_step_state;
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  AxisShaper Stepper::shaper[2];
+  uint32_t Stepper::shaping_time; // = 0
+  bool Stepper::shaping_paused; // = false
+#endif
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
@@ -458,14 +486,14 @@ void Stepper::set_directions() {
 
   DIR_WAIT_BEFORE();
 
-  #define SET_STEP_DIR(A)                       \
-    if (motor_direction(_AXIS(A))) {            \
-      A##_APPLY_DIR(INVERT_##A##_DIR, false);   \
-      count_direction[_AXIS(A)] = -1;           \
-    }                                           \
-    else {                                      \
-      A##_APPLY_DIR(!INVERT_##A##_DIR, false);  \
-      count_direction[_AXIS(A)] = 1;            \
+  #define SET_STEP_DIR(A)                                       \
+    if (motor_direction(_AXIS(A))) {                            \
+      if (!A##_SHAPED) A##_APPLY_DIR(INVERT_##A##_DIR, false);  \
+      count_direction[_AXIS(A)] = -1;                           \
+    }                                                           \
+    else {                                                      \
+      if (!A##_SHAPED) A##_APPLY_DIR(!INVERT_##A##_DIR, false); \
+      count_direction[_AXIS(A)] = 1;                            \
     }
 
   #if HAS_X_DIR
@@ -1353,6 +1381,8 @@ HAL_STEP_TIMER_ISR() {
 
 void Stepper::isr() {
 
+  PROFILE_STEPPER_PHASE(ISR);
+
   static uint32_t nextMainISR = 0;  // Interval until the next main Stepper Pulse phase (0 = Now)
 
   #ifndef __AVR__
@@ -1378,20 +1408,40 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) {                                             // 0 = Do coordinated axes Stepper pulses
+      PROFILE_STEPPER_PHASE(PULSE);
+      pulse_phase_isr();
+    }
 
     #if ENABLED(LIN_ADVANCE)
-      if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
+      if (!nextAdvanceISR) {                                        // 0 = Do Linear Advance E Stepper pulses
+        PROFILE_STEPPER_PHASE(ADVANCE);
+        nextAdvanceISR = advance_isr();
+      }
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       const bool is_babystep = (nextBabystepISR == 0);              // 0 = Do Babystepping (XY)Z pulses
-      if (is_babystep) nextBabystepISR = babystepping_isr();
+      if (is_babystep) {
+        PROFILE_STEPPER_PHASE(BABYSTEP);
+        nextBabystepISR = babystepping_isr();
+      }
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      uint32_t nextShapingISR;                                      // Shaper impulses due now, then the time to the next
+      {
+        PROFILE_STEPPER_PHASE(SHAPING);
+        nextShapingISR = shaping_isr();
+      }
     #endif
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
-    if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
+    if (!nextMainISR) {                                 // Manage acc/deceleration, get next block
+      PROFILE_STEPPER_PHASE(BLOCK);
+      nextMainISR = block_phase_isr();
+    }
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (is_babystep)                                  // Avoid ANY stepping too soon after baby-stepping
@@ -1410,6 +1460,9 @@ void Stepper::isr() {
       #if ENABLED(INTEGRATED_BABYSTEPPING)
         , nextBabystepISR                               // Come back early for Babystepping?
       #endif
+      #if ENABLED(INPUT_SHAPING)
+        , nextShapingISR                                // Come back early for a shaper impulse?
+      #endif
       , uint32_t(HAL_TIMER_TYPE_MAX)                    // Come back in a very long time
     );
 
@@ -1430,6 +1483,8 @@ void Stepper::isr() {
       if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval;
     #endif
 
+    TERN_(INPUT_SHAPING, shaping_time += interval);
+
     /**
      * This needs to avoid a race-condition caused by interleaving
      * of interrupts required by both the LA and Stepper algorithms.
@@ -1509,6 +1564,18 @@ void Stepper::isr() {
   #define ISR_MULTI_STEPS 1
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  // Set a shaped axis motor direction for an output step, if it changed
+  #define SHAPING_DIR(AXIS, S) do{ \
+    if (shaper[_AXIS(AXIS)].out_dir != (S)) { \
+      shaper[_AXIS(AXIS)].out_dir = (S); \
+      DIR_WAIT_BEFORE(); \
+      AXIS##_APPLY_DIR((S) < 0 ? INVERT_##AXIS##_DIR : !INVERT_##AXIS##_DIR, false); \
+      DIR_WAIT_AFTER(); \
+    } \
+  }while(0)
+#endif
+
 /**
  * This phase of the ISR should ONLY create the pulses for the steppers.
  * This prevents jitter caused by the interval between the start of the
@@ -1683,12 +1750,46 @@ void Stepper::pulse_phase_isr() {
 
     if (!is_page) {
       // Determine if pulses are needed
-      #if HAS_X_STEP
-        PULSE_PREP(X);
-      #endif
-      #if HAS_Y_STEP
-        PULSE_PREP(Y);
+      #if ENABLED(ARC_BLOCKS)
+        if (IS_ARC(current_block)) {
+          // Rotate the unit vector by one step event's angle
+          const arc_steps_t &arc = current_block->arc;
+          const int32_t c = arc_cos, s = arc_sin;
+          arc_cos = int32_t((int64_t(c) * arc.cos_d - int64_t(s) * arc.sin_d + (1L << (ARC_UNIT_BITS - 1))) >> ARC_UNIT_BITS);
+          arc_sin = int32_t((int64_t(s) * arc.cos_d + int64_t(c) * arc.sin_d + (1L << (ARC_UNIT_BITS - 1))) >> ARC_UNIT_BITS);
+          --arc_events_left;
+
+          // Step towards the distance from the arc start, never falling
+          // so far behind that the remaining events can't catch up
+          #define ARC_PULSE_PREP(AXIS, RADIUS, V, V0) do{ \
+            const uint32_t steps = current_block->steps[_AXIS(AXIS)]; \
+            uint32_t want = uint32_t((ABS(int64_t(arc.RADIUS) * (int64_t(V) - (V0))) + (1LL << (ARC_UNIT_BITS + ARC_RADIUS_BITS - 1))) >> (ARC_UNIT_BITS + ARC_RADIUS_BITS)); \
+            NOMORE(want, steps); \
+            if (arc_events_left < steps) NOLESS(want, steps - arc_events_left); \
+            step_needed[_AXIS(AXIS)] = (arc_done[_AXIS(AXIS)] < want); \
+            if (step_needed[_AXIS(AXIS)]) { \
+              arc_done[_AXIS(AXIS)]++; \
+              count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+            } \
+          }while(0)
+
+          #if HAS_X_STEP
+            ARC_PULSE_PREP(X, radius_x, arc_cos, arc.cos_0);
+          #endif
+          #if HAS_Y_STEP
+            ARC_PULSE_PREP(Y, radius_y, arc_sin, arc.sin_0);
+          #endif
+        }
+        else
       #endif
+      {
+        #if HAS_X_STEP
+          PULSE_PREP(X);
+        #endif
+        #if HAS_Y_STEP
+          PULSE_PREP(Y);
+        #endif
+      }
       #if HAS_Z_STEP
         PULSE_PREP(Z);
       #endif
@@ -1710,6 +1811,24 @@ void Stepper::pulse_phase_isr() {
       #endif
     }
 
+    #if ENABLED(INPUT_SHAPING)
+      // A shaped axis only steps once its impulses add up to a step
+      #define SHAPING_PREP(AXIS) do{ \
+        if (AXIS##_SHAPED && step_needed[_AXIS(AXIS)]) { \
+          const int8_t s = shaper[_AXIS(AXIS)].add(shaping_time, count_direction[_AXIS(AXIS)] < 0); \
+          if (s) SHAPING_DIR(AXIS, s); \
+          step_needed[_AXIS(AXIS)] = !!s; \
+        } \
+      }while(0)
+
+      #if HAS_X_STEP
+        SHAPING_PREP(X);
+      #endif
+      #if HAS_Y_STEP
+        SHAPING_PREP(Y);
+      #endif
+    #endif
+
     #if ISR_MULTI_STEPS
       if (firstStep)
         firstStep = false;
@@ -2100,6 +2219,7 @@ uint32_t Stepper::block_phase_isr() {
         uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
         // Decide if axis smoothing is possible
         uint32_t max_rate = current_block->nominal_rate;    // Get the step event rate
+        if (IS_ARC(current_block)) max_rate = MIN_STEP_ISR_FREQUENCY; // Arcs step at their planned event rate
         while (max_rate < MIN_STEP_ISR_FREQUENCY) {         // As long as more ISRs are possible...
           max_rate <<= 1;                                   // Try to double the rate
           if (max_rate < MIN_STEP_ISR_FREQUENCY)            // Don't exceed the estimated ISR limit
@@ -2123,6 +2243,15 @@ uint32_t Stepper::block_phase_isr() {
       // No step events completed so far
       step_events_completed = 0;
 
+      #if ENABLED(ARC_BLOCKS)
+        if (IS_ARC(current_block)) {
+          arc_cos = current_block->arc.cos_0;
+          arc_sin = current_block->arc.sin_0;
+          arc_done.reset();
+          arc_events_left = step_event_count;
+        }
+      #endif
+
       // Compute the acceleration and deceleration points
       accelerate_until = current_block->accelerate_until << oversampling;
       decelerate_after = current_block->decelerate_after << oversampling;
@@ -2343,6 +2472,59 @@ uint32_t Stepper::block_phase_isr() {
 
 #endif // LIN_ADVANCE
 
+#if ENABLED(INPUT_SHAPING)
+
+  // Timer interrupt for the later shaper impulses. Output the steps that are due.
+  uint32_t Stepper::shaping_isr() {
+    #if ISR_MULTI_STEPS
+      bool firstStep = true;
+      USING_TIMED_PULSE();
+    #endif
+
+    #define SHAPING_ECHO(AXIS) do{ \
+      int8_t s; \
+      while (shaper[_AXIS(AXIS)].echo(shaping_time, s)) { \
+        if (!s) continue; \
+        SHAPING_DIR(AXIS, s); \
+        TERN_(ISR_MULTI_STEPS, if (firstStep) firstStep = false; else AWAIT_LOW_PULSE()); \
+        AXIS##_APPLY_STEP(!INVERT_##AXIS##_STEP_PIN, 0); \
+        TERN_(ISR_PULSE_CONTROL, START_HIGH_PULSE()); \
+        TERN_(ISR_PULSE_CONTROL, AWAIT_HIGH_PULSE()); \
+        AXIS##_APPLY_STEP(INVERT_##AXIS##_STEP_PIN, 0); \
+        TERN_(ISR_MULTI_STEPS, START_LOW_PULSE()); \
+      } \
+    }while(0)
+
+    if (X_SHAPED) SHAPING_ECHO(X);
+    if (Y_SHAPED) SHAPING_ECHO(Y);
+
+    return _MIN(shaper[X_AXIS].next(shaping_time), shaper[Y_AXIS].next(shaping_time));
+  }
+
+  void Stepper::set_shaping(const AxisEnum axis, const shaping_settings_t &s) {
+    shaper[axis].settings = s;
+    apply_shaping();
+  }
+
+  void Stepper::pause_shaping(const bool pause) {
+    shaping_paused = pause;
+    apply_shaping();
+  }
+
+  // Wait for the shapers to finish, then set them up
+  void Stepper::apply_shaping() {
+    planner.synchronize();
+    const bool was_on = suspend();
+    shaper[X_AXIS].apply(!shaping_paused);
+    shaper[Y_AXIS].apply(!shaping_paused);
+    if (was_on) {
+      set_directions();   // Motors may point the way the last shaped step went
+      wake_up();
+    }
+  }
+
+#endif // INPUT_SHAPING
+
 #if ENABLED(INTEGRATED_BABYSTEPPING)
 
   // Timer interrupt for baby-stepping
@@ -2576,6 +2758,8 @@ void Stepper::init() {
     E_AXIS_INIT(7);
   #endif
 
+  TERN_(STEPPER_ISR_PROFILER, stepper_profiler.init());
+
   #if DISABLED(I2S_STEPPER_STREAM)
     HAL_timer_start(STEP_TIMER_NUM, 122); // Init Stepper ISR to 122 Hz for quick starting
     wake_up();
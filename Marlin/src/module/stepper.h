@@ -45,6 +45,9 @@
 
 #include "planner.h"
 #include "stepper/indirection.h"
+#if ENABLED(INPUT_SHAPING)
+  #include "../feature/input_shaping.h"
+#endif
 #ifdef __AVR__
   #include "speed_lookuptable.h"
 #endif
@@ -253,6 +256,10 @@ class Stepper {
       static bool initialized;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      static AxisShaper shaper[2];          // X and Y input shapers
+    #endif
+
   private:
 
     static block_t* current_block;          // A pointer to the block currently being traced
@@ -304,6 +311,12 @@ class Stepper {
                     decelerate_after,       // The point from where we need to start decelerating
                     step_event_count;       // The total event count for the current block
 
+    #if ENABLED(ARC_BLOCKS)
+      static int32_t arc_cos, arc_sin;    // Unit vector from the arc center, in Q30 fixed-point
+      static xy_ulong_t arc_done;         // X and Y steps taken along the current arc
+      static uint32_t arc_events_left;    // Step events left in the current arc
+    #endif
+
     #if EXTRUDERS > 1 || ENABLED(MIXING_EXTRUDER)
       static uint8_t stepper_extruder;
     #else
@@ -339,6 +352,11 @@ class Stepper {
       static page_step_state_t page_step_state;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      static uint32_t shaping_time;         // Stepper timer ticks, the clock for shaper impulses
+      static bool shaping_paused;           // Homing without shaping
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -405,6 +423,19 @@ class Stepper {
       FORCE_INLINE static void initiateLA() { nextAdvanceISR = 0; }
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // The input shaping ISR phase
+      static uint32_t shaping_isr();
+
+      // Use new shaper settings or pause shaping, once all motion is done
+      static void set_shaping(const AxisEnum axis, const shaping_settings_t &s);
+      static void pause_shaping(const bool pause);
+      static void apply_shaping();
+
+      // Shaped steps still to be output
+      static inline bool shaping_busy() { return shaper[X_AXIS].busy() || shaper[Y_AXIS].busy(); }
+    #endif
+
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       // The Babystepping ISR phase
       static uint32_t babystepping_isr();
@@ -29,13 +29,14 @@
  */
 
 #include "../inc/MarlinConfig.h"
+
+#if ENABLED(SDSUPPORT) && NONE(USB_FLASH_DRIVE_SUPPORT, SDIO_SUPPORT) && !defined(__PLAT_LINUX__)
+
 #if SD_CONNECTION_IS(LCD_AND_ONBOARD)
  #define NEED_SPI_TEMPLATE_CLASS
 #endif
 #include <SPI.h>
 
-#if ENABLED(SDSUPPORT) && NONE(USB_FLASH_DRIVE_SUPPORT, SDIO_SUPPORT)
-
 #if SD_CONNECTION_IS(LCD_AND_ONBOARD)
  #if ENABLED(LPC_SOFTWARE_SPI)
    SoftwareSPI<> SPI_LCD; //slow, but no conflicts with Fysetc Display
@@ -110,6 +111,11 @@
 
 // Send command and return error code. Return zero for OK
 uint8_t Sd2Card::cardCommand(const uint8_t cmd, const uint32_t arg) {
+  // Any other command ends a multi-block read
+  #if ENABLED(SD_MULTIBLOCK_READ)
+    if (streaming_ && cmd != CMD12) stopStream();
+  #endif
+
   // Select card
   chipSelect();
 
@@ -254,6 +260,7 @@ bool Sd2Card::eraseSingleBlockEnable() {
  */
 bool Sd2Card::init(const uint8_t sckRateID, const pin_t chipSelectPin, const uint16_t timeout /*= SD_INIT_TIMEOUT*/) {
   errorCode_ = type_ = 0;
+  TERN_(SD_MULTIBLOCK_READ, streaming_ = false);  // A new card isn't streaming
   chipSelectPin_ = chipSelectPin;
   // 16-bit init start time allows over a minute
   const millis_t init_timeout = millis() + timeout;
@@ -530,6 +537,35 @@ bool Sd2Card::readStop() {
   return success;
 }
 
+#if ENABLED(SD_MULTIBLOCK_READ)
+
+  /**
+   * Read a block of a file read in order. While the blocks follow on,
+   * keep one CMD18 read open and take the next block straight from it,
+   * without a command and response per block. A jump to another block
+   * or any other command stops it.
+   */
+  bool Sd2Card::readSequential(const uint32_t blockNumber, uint8_t* dst) {
+    if (streaming_ && blockNumber != streamBlock_) stopStream();
+    if (!streaming_) {
+      if (!readStart(blockNumber)) return false;
+      streaming_ = true;
+    }
+    if (!readData(dst)) {
+      stopStream();
+      return readBlock(blockNumber, dst);   // Try once more on its own
+    }
+    streamBlock_ = blockNumber + 1;
+    return true;
+  }
+
+  void Sd2Card::stopStream() {
+    streaming_ = false;
+    readStop();
+  }
+
+#endif // SD_MULTIBLOCK_READ
+
 /**
  * Set the SPI clock rate.
  *
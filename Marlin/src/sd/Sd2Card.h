@@ -93,7 +93,7 @@ uint8_t const SD_CARD_TYPE_SD1  = 1,                    // Standard capacity V1
 class Sd2Card {
 public:
 
-  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) { TERN_(SD_MULTIBLOCK_READ, streaming_ = false); }
 
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
@@ -147,6 +147,9 @@ public:
   bool readData(uint8_t* dst);
   bool readStart(uint32_t blockNumber);
   bool readStop();
+  #if ENABLED(SD_MULTIBLOCK_READ)
+    bool readSequential(const uint32_t blockNumber, uint8_t* dst);
+  #endif
   bool setSckRate(const uint8_t sckRateID);
 
   /**
@@ -169,6 +172,12 @@ private:
           status_,
           type_;
 
+  #if ENABLED(SD_MULTIBLOCK_READ)
+    bool streaming_;          // A CMD18 read is open
+    uint32_t streamBlock_;    // The block it will send next
+    void stopStream();
+  #endif
+
   // private functions
   inline uint8_t cardAcmd(const uint8_t cmd, const uint32_t arg) {
     cardCommand(CMD55, 0);
@@ -0,0 +1,82 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * The SD card of the LINUX simulator: the blocks of a disk image file.
+ * Make one with buildroot/share/scripts/make_sd_image.py and start the
+ * simulator with --sd-image <file>. See HAL/LINUX/sd_image.cpp.
+ *
+ * The card takes as long as an SPI card would, by the timing model, and
+ * fails blocks at random by the error model. In virtual time the waits
+ * move the clock on and run the timer ISRs, as a busy wait would.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#ifdef __PLAT_LINUX__
+
+class Sd2Card {
+public:
+  typedef struct {
+    uint32_t command_us,  // Each command, its response and the wait for the data token
+             block_us,    // Each 512-byte block sent or received
+             busy_us;     // Each block written, until the card is ready again
+  } timing_t;
+
+  typedef struct {
+    uint32_t one_in,      // Fail about one block in this many. 0 = never.
+             seed;
+  } errors_t;
+
+  typedef struct {
+    uint32_t commands, blocks_read, blocks_written, errors;
+    uint64_t busy_ns;     // Time spent waiting on the card
+  } stats_t;
+
+  static const char *image;   // Image file, from the command line
+  static timing_t timing;
+  static errors_t errors;
+  static stats_t stats;
+
+  bool init(const uint8_t sckRateID=0, const pin_t chipSelectPin=0);
+
+  bool readBlock(uint32_t block, uint8_t *dst);
+  bool writeBlock(uint32_t block, const uint8_t *src);
+  #if ENABLED(SD_MULTIBLOCK_READ)
+    bool readSequential(const uint32_t block, uint8_t *dst);
+  #endif
+
+  uint32_t cardSize();
+
+private:
+  int fd_ = -1;
+  #if ENABLED(SD_MULTIBLOCK_READ)
+    bool streaming_ = false;  // A CMD18 read is open
+    uint32_t streamBlock_;    // The block it will send next
+  #endif
+
+  void command();
+  bool transfer(const uint32_t block, uint8_t *dst, const uint8_t *src);
+};
+
+#endif // __PLAT_LINUX__
@@ -765,6 +765,12 @@ bool SdBaseFile::openCachedEntry(uint8_t dirIndex, uint8_t oflag) {
   // set to start of file
   curCluster_ = 0;
   curPosition_ = 0;
+  #ifdef SD_FILE_EXTENTS
+    if (extents_) {
+      extents_->clusters = 0;
+      if (type_ == FAT_FILE_TYPE_NORMAL && !(oflag & O_WRITE)) mapExtents();
+    }
+  #endif
   if ((oflag & O_TRUNC) && !truncate(0)) return false;
   return oflag & O_AT_END ? seekEnd(0) : true;
 
@@ -902,6 +908,9 @@ bool SdBaseFile::openRoot(SdVolume* vol) {
   vol_ = vol;
   // read only
   flags_ = O_READ;
+  #ifdef SD_FILE_EXTENTS
+    if (extents_) extents_->clusters = 0;
+  #endif
 
   // set to start of file
   curCluster_ = curPosition_ = 0;
@@ -1033,7 +1042,7 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
         // start of new cluster
         if (curPosition_ == 0)
           curCluster_ = firstCluster_;                      // use first cluster in file
-        else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
+        else if (!nextCluster())                            // get next cluster
           return -1;
       }
       block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
@@ -1045,7 +1054,7 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
 
     // no buffering needed if n == 512
     if (n == 512 && block != vol_->cacheBlockNumber()) {
-      if (!vol_->readBlock(block, dst)) return -1;
+      if (!vol_->readDataBlock(block, dst)) return -1;
     }
     else {
       // read block to cache and copy data to caller
@@ -1440,8 +1449,22 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
   nCur = (curPosition_ - 1) >> (vol_->clusterSizeShift_ + 9);
   nNew = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
 
-  if (nNew < nCur || curPosition_ == 0)
+  #ifdef SD_FILE_EXTENTS
+    if (mappedCluster(nNew, &curCluster_)) {
+      curPosition_ = pos;
+      return true;
+    }
+  #endif
+
+  if (nNew < nCur || curPosition_ == 0) {
+    #ifdef SD_FILE_EXTENTS
+      const uint32_t last = extents_ ? extents_->clusters : 0;
+      if (last && mappedCluster(last - 1, &curCluster_))
+        nNew -= last - 1;             // follow chain from the last mapped cluster
+      else
+    #endif
     curCluster_ = firstCluster_;      // must follow chain from first cluster
+  }
   else
     nNew -= nCur;                     // advance from curPosition
 
@@ -1457,6 +1480,73 @@ void SdBaseFile::setpos(filepos_t* pos) {
   curCluster_ = pos->cluster;
 }
 
+/**
+ * Move to the cluster that follows curCluster_, for the position
+ * curPosition_ at the start of a cluster.
+ *
+ * \return true for success, false for failure.
+ */
+bool SdBaseFile::nextCluster() {
+  #ifdef SD_FILE_EXTENTS
+    if (mappedCluster(curPosition_ >> (vol_->clusterSizeShift_ + 9), &curCluster_)) return true;
+  #endif
+  return vol_->fatGet(curCluster_, &curCluster_);
+}
+
+#ifdef SD_FILE_EXTENTS
+
+  /**
+   * Walk the cluster chain of a file opened for reading into extents_.
+   * Each FAT block is read once, here, and not again between data blocks.
+   * A file in more runs than SD_FILE_EXTENTS is mapped up to the last run
+   * and the rest of the chain is walked in the FAT as usual.
+   */
+  void SdBaseFile::mapExtents() {
+    SdExtents &e = *extents_;
+    e.runs = 0;
+    if (!firstCluster_ || !fileSize_) return;
+
+    const uint32_t count = ((fileSize_ - 1) >> (vol_->clusterSizeShift_ + 9)) + 1;
+    uint32_t c = firstCluster_;
+    e.run[0].cluster = c;
+    e.run[0].count = 1;
+    e.runs = 1;
+    e.clusters = 1;
+    while (e.clusters < count) {
+      uint32_t next;
+      if (!vol_->fatGet(c, &next) || vol_->isEOC(next)) break;
+      if (next == c + 1)
+        e.run[e.runs - 1].count++;
+      else if (e.runs < SD_FILE_EXTENTS) {
+        e.run[e.runs].cluster = next;
+        e.run[e.runs].count = 1;
+        e.runs++;
+      }
+      else
+        break;
+      c = next;
+      e.clusters++;
+    }
+  }
+
+  /**
+   * Get the cluster with index \a n in the file from its mapped runs.
+   *
+   * \return true if the cluster is mapped, false to walk the FAT instead.
+   */
+  bool SdBaseFile::mappedCluster(uint32_t n, uint32_t* cluster) {
+    if (!extents_ || n >= extents_->clusters) return false;
+    for (uint8_t i = 0;; i++) {
+      if (n < extents_->run[i].count) {
+        *cluster = extents_->run[i].cluster + n;
+        return true;
+      }
+      n -= extents_->run[i].count;
+    }
+  }
+
+#endif
+
 /**
  * The sync() call causes all modified data and directory fields
  * to be written to the storage device.
@@ -1489,7 +1579,8 @@ bool SdBaseFile::sync() {
     // clear directory dirty
     flags_ &= ~F_FILE_DIR_DIRTY;
   }
-  return vol_->cacheFlush();
+  // Wait for the write-behind queue too, so all is on the card
+  if (vol_->cacheFlush() && TERN1(SD_WRITE_BEHIND, SdWriteQueue::flush())) return true;
 
   FAIL:
   writeError = true;
@@ -159,6 +159,22 @@ uint16_t const FAT_DEFAULT_DATE = ((2000 - 1980) << 9) | (1 << 5) | 1;
 // Default time for file timestamp is 1 am
 uint16_t const FAT_DEFAULT_TIME = (1 << 11);
 
+#ifdef SD_FILE_EXTENTS
+  /**
+   * \struct SdExtents
+   * \brief The runs of clusters of a file, from its first cluster.
+   *
+   * Given to a file with SdBaseFile::useExtents. When the file is opened for
+   * reading the FAT is walked once and the runs are kept, so reads and seeks
+   * find their clusters without reading the FAT again.
+   */
+  struct SdExtents {
+    struct { uint32_t cluster, count; } run[SD_FILE_EXTENTS];
+    uint8_t runs;             // Runs in use, 1 for a contiguous file
+    uint32_t clusters;        // Clusters covered by the runs
+  };
+#endif
+
 /**
  * \class SdBaseFile
  * \brief Base class for SdFile with Print and C++ streams.
@@ -192,6 +208,13 @@ class SdBaseFile {
 
   bool close();
   bool contiguousRange(uint32_t* bgnBlock, uint32_t* endBlock);
+  #ifdef SD_FILE_EXTENTS
+    /**
+     * Keep the cluster runs of the file in \a ext from the next open for reading
+     * \param[in] ext Storage for the runs, or nullptr to walk the FAT as usual
+     */
+    void useExtents(SdExtents* ext) { extents_ = ext; }
+  #endif
   bool createContiguous(SdBaseFile* dirFile,
                         const char* path, uint32_t size);
   /**
@@ -368,6 +391,9 @@ class SdBaseFile {
   uint32_t  fileSize_;      // file size in bytes
   uint32_t  firstCluster_;  // first cluster of file
   SdVolume* vol_;           // volume where file is located
+  #ifdef SD_FILE_EXTENTS
+    SdExtents* extents_ = nullptr;  // cluster runs of a file open for reading
+  #endif
 
   /**
    * EXPERIMENTAL - Don't use!
@@ -377,6 +403,11 @@ class SdBaseFile {
   // private functions
   bool addCluster();
   bool addDirCluster();
+  #ifdef SD_FILE_EXTENTS
+    void mapExtents();
+    bool mappedCluster(uint32_t n, uint32_t* cluster);
+  #endif
+  bool nextCluster();
   dir_t* cacheDirEntry(uint8_t action);
   int8_t lsPrintNext(uint8_t flags, uint8_t indent);
   static bool make83Name(const char* str, uint8_t* name, const char** ptr);
@@ -121,12 +121,12 @@ bool SdVolume::allocContiguous(uint32_t count, uint32_t* curCluster) {
 bool SdVolume::cacheFlush() {
   #if DISABLED(SDCARD_READONLY)
     if (cacheDirty_) {
-      if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data))
+      if (!TERN(SD_WRITE_BEHIND, SdWriteQueue::write(sdCard_, cacheBlockNumber_, cacheBuffer_.data), sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data)))
         return false;
 
       // mirror FAT tables
       if (cacheMirrorBlock_) {
-        if (!sdCard_->writeBlock(cacheMirrorBlock_, cacheBuffer_.data))
+        if (!TERN(SD_WRITE_BEHIND, SdWriteQueue::write(sdCard_, cacheMirrorBlock_, cacheBuffer_.data), sdCard_->writeBlock(cacheMirrorBlock_, cacheBuffer_.data)))
           return false;
         cacheMirrorBlock_ = 0;
       }
@@ -139,7 +139,8 @@ bool SdVolume::cacheFlush() {
 bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty) {
   if (cacheBlockNumber_ != blockNumber) {
     if (!cacheFlush()) return false;
-    if (!sdCard_->readBlock(blockNumber, cacheBuffer_.data)) return false;
+    if (!TERN0(SD_WRITE_BEHIND, SdWriteQueue::read(sdCard_, blockNumber, cacheBuffer_.data))
+        && !sdCard_->readBlock(blockNumber, cacheBuffer_.data)) return false;
     cacheBlockNumber_ = blockNumber;
   }
   if (dirty) cacheDirty_ = true;
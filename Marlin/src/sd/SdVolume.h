@@ -41,6 +41,8 @@
   #include "usb_flashdrive/Sd2Card_FlashDrive.h"
 #elif ENABLED(SDIO_SUPPORT)
   #include "Sd2Card_sdio.h"
+#elif defined(__PLAT_LINUX__)
+  #include "Sd2Card_image.h"
 #else
   #include "Sd2Card.h"
 #endif
@@ -48,6 +50,10 @@
 #include "SdFatConfig.h"
 #include "SdFatStructs.h"
 
+#if ENABLED(SD_WRITE_BEHIND)
+  #include "SdWriteQueue.h"
+#endif
+
 //==============================================================================
 // SdVolume class
 /**
@@ -196,6 +202,16 @@ class SdVolume {
     if (fatType_ == 16) return cluster >= FAT16EOC_MIN;
     return  cluster >= FAT32EOC_MIN;
   }
-  bool readBlock(uint32_t block, uint8_t* dst) { return sdCard_->readBlock(block, dst); }
-  bool writeBlock(uint32_t block, const uint8_t* dst) { return sdCard_->writeBlock(block, dst); }
+  // Blocks still waiting to be written are read from the write-behind queue
+  bool readBlock(uint32_t block, uint8_t* dst) {
+    return TERN0(SD_WRITE_BEHIND, SdWriteQueue::read(sdCard_, block, dst)) || sdCard_->readBlock(block, dst);
+  }
+  // A whole block of file data, read in file order
+  bool readDataBlock(uint32_t block, uint8_t* dst) {
+    return TERN0(SD_WRITE_BEHIND, SdWriteQueue::read(sdCard_, block, dst))
+        || TERN(SD_MULTIBLOCK_READ, sdCard_->readSequential(block, dst), sdCard_->readBlock(block, dst));
+  }
+  bool writeBlock(uint32_t block, const uint8_t* dst) {
+    return TERN(SD_WRITE_BEHIND, SdWriteQueue::write(sdCard_, block, dst), sdCard_->writeBlock(block, dst));
+  }
 };
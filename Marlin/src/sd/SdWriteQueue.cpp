@@ -0,0 +1,100 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Write-behind for whole blocks going to the card
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if BOTH(SDSUPPORT, SD_WRITE_BEHIND)
+
+#include "SdWriteQueue.h"
+#include "SdVolume.h"
+
+SdWriteQueue::entry_t SdWriteQueue::entry[SD_WRITE_BEHIND_BLOCKS];
+uint8_t SdWriteQueue::head, SdWriteQueue::count;
+bool SdWriteQueue::failed;
+
+// The queue index of a waiting block, or -1
+int8_t SdWriteQueue::find(Sd2Card * const card, const uint32_t block) {
+  for (uint8_t i = 0, e = head; i < count; i++, e = (e + 1) % (SD_WRITE_BEHIND_BLOCKS))
+    if (entry[e].block == block && entry[e].card == card) return e;
+  return -1;
+}
+
+// Write the oldest block. A block that fails is dropped and reported by flush().
+void SdWriteQueue::writeOldest() {
+  entry_t &e = entry[head];
+  if (!e.card->writeBlock(e.block, e.data)) failed = true;
+  head = (head + 1) % (SD_WRITE_BEHIND_BLOCKS);
+  count--;
+}
+
+/**
+ * Queue a block to be written, copied from \a src
+ *
+ * \return true, or false if the queue was full and writing the oldest block failed.
+ */
+bool SdWriteQueue::write(Sd2Card * const card, const uint32_t block, const uint8_t * const src) {
+  int8_t e = find(card, block);
+  if (e < 0) {
+    if (count == SD_WRITE_BEHIND_BLOCKS) {
+      writeOldest();
+      if (failed) return (failed = false);
+    }
+    e = (head + count++) % (SD_WRITE_BEHIND_BLOCKS);
+    entry[e].card = card;
+    entry[e].block = block;
+  }
+  memcpy(entry[e].data, src, 512);
+  return true;
+}
+
+/**
+ * Copy a waiting block to \a dst
+ *
+ * \return true if the block is waiting, false to read it from the card.
+ */
+bool SdWriteQueue::read(Sd2Card * const card, const uint32_t block, uint8_t * const dst) {
+  const int8_t e = find(card, block);
+  if (e < 0) return false;
+  memcpy(dst, entry[e].data, 512);
+  return true;
+}
+
+// Write one block, a bounded piece of work for each idle()
+void SdWriteQueue::idle() { if (count) writeOldest(); }
+
+/**
+ * Write all waiting blocks
+ *
+ * \return true if all the writes since the last flush() worked.
+ */
+bool SdWriteQueue::flush() {
+  while (count) writeOldest();
+  const bool ok = !failed;
+  failed = false;
+  return ok;
+}
+
+#endif // SDSUPPORT && SD_WRITE_BEHIND
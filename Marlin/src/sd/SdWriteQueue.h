@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * \file
+ * \brief SdWriteQueue class
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#include <stdint.h>
+
+class Sd2Card;
+
+/**
+ * \class SdWriteQueue
+ * \brief Write-behind for whole blocks going to the card.
+ *
+ * SdVolume puts every block it writes here, to be written from idle() one
+ * at a time, so a write on the main loop doesn't wait for the card. Blocks
+ * go out in order. A block written again while waiting is updated in place,
+ * and reads of a waiting block are served from the queue. When the queue is
+ * full the oldest block is written first. SdBaseFile::sync() (and so close)
+ * is the barrier that waits for all of them.
+ */
+class SdWriteQueue {
+ public:
+  static bool write(Sd2Card * const card, const uint32_t block, const uint8_t * const src);
+  static bool read(Sd2Card * const card, const uint32_t block, uint8_t * const dst);
+  static void idle();
+  static bool flush();
+  static uint8_t waiting() { return count; }
+
+ private:
+  typedef struct {
+    Sd2Card *card;
+    uint32_t block;
+    uint8_t data[512];
+  } entry_t;
+
+  static entry_t entry[SD_WRITE_BEHIND_BLOCKS];
+  static uint8_t head, count;   // Oldest block and blocks waiting
+  static bool failed;           // A write failed since the last flush()
+
+  static int8_t find(Sd2Card * const card, const uint32_t block);
+  static void writeOldest();
+};
@@ -111,6 +111,9 @@ uint8_t CardReader::workDirDepth;
 Sd2Card CardReader::sd2card;
 SdVolume CardReader::volume;
 SdFile CardReader::file;
+#ifdef SD_FILE_EXTENTS
+  SdExtents CardReader::fileExtents;
+#endif
 
 uint8_t CardReader::file_subcall_ctr;
 uint32_t CardReader::filespos[SD_PROCEDURE_DEPTH];
@@ -118,6 +121,10 @@ char CardReader::proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(SD_READ_AHEAD)
+  CardReader::read_ahead_t CardReader::ahead[2];
+#endif
+
 CardReader::CardReader() {
   #if ENABLED(SDCARD_SORT_ALPHA)
     sort_count = 0;
@@ -134,6 +141,10 @@ CardReader::CardReader() {
   workDirDepth = 0;
   ZERO(workDirParents);
 
+  #ifdef SD_FILE_EXTENTS
+    file.useExtents(&fileExtents);
+  #endif
+
   // Disable autostart until card is initialized
   autostart_index = -1;
 
@@ -448,6 +459,8 @@ void CardReader::manage_media() {
 
 void CardReader::release() {
   endFilePrint();
+  TERN_(POWER_LOSS_JOURNAL, recovery.close());
+  TERN_(SD_WRITE_BEHIND, SdWriteQueue::flush());
   flag.mounted = false;
   flag.workDirIsRoot = true;
   #if ALL(SDCARD_SORT_ALPHA, SDSORT_USES_RAM, SDSORT_CACHE_NAMES)
@@ -579,6 +592,7 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
   if (file.open(curDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(SD_READ_AHEAD, ahead[0].len = ahead[1].len = 0);
 
     PORT_REDIRECT(SERIAL_BOTH);
     SERIAL_ECHOLNPAIR(STR_SD_FILE_OPENED, fname, STR_SD_SIZE, filesize);
@@ -1181,6 +1195,50 @@ void CardReader::fileHasFinished() {
   }
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  // Read the block of the file at 'start' into a read-ahead buffer
+  bool CardReader::fill_ahead(read_ahead_t &b, const uint32_t start) {
+    b.len = 0;
+    if (file.curPosition() != start && !file.seekSet(start)) return false;
+    const int16_t n = file.read(b.data, _MIN(filesize - start, 512UL));
+    if (n <= 0) return false;
+    b.start = start;
+    b.len = n;
+    return true;
+  }
+
+  /**
+   * Get the bytes from sdpos to the end of its block, reading the block
+   * unless it's already buffered. Whole aligned blocks are read straight
+   * into the buffer, so the volume cache is left alone.
+   */
+  const char* CardReader::read_ahead(uint16_t &len) {
+    len = 0;
+    if (eof()) return nullptr;
+    const uint32_t start = sdpos & ~0x1FFUL;
+    read_ahead_t *b = ahead;
+    if (!b->len || b->start != start) {
+      b = &ahead[1];
+      if (!b->len || b->start != start) {
+        b = &ahead[ahead[0].len && ahead[0].start == start + 512 ? 1 : 0];  // Keep a prefetched block
+        if (!fill_ahead(*b, start)) return nullptr;
+      }
+    }
+    const uint16_t ind = sdpos - start;
+    len = b->len - ind;
+    return &b->data[ind];
+  }
+
+  // Read the block after the current one, while the command queue is full
+  void CardReader::prefetch() {
+    const uint32_t start = (sdpos | 0x1FFUL) + 1;
+    if (start >= filesize || (ahead[0].len && ahead[0].start == start) || (ahead[1].len && ahead[1].start == start)) return;
+    fill_ahead(ahead[ahead[0].len && ahead[0].start == start - 512 ? 1 : 0], start);
+  }
+
+#endif // SD_READ_AHEAD
+
 #if ENABLED(AUTO_REPORT_SD_STATUS)
   uint8_t CardReader::auto_report_sd_interval = 0;
   millis_t CardReader::next_sd_report_ms;
@@ -1201,6 +1259,7 @@ void CardReader::fileHasFinished() {
 #if ENABLED(POWER_LOSS_RECOVERY)
 
   bool CardReader::jobRecoverFileExists() {
+    if (recovery.file.isOpen()) return true;
     const bool exists = recovery.file.open(&root, recovery.filename, O_READ);
     if (exists) recovery.file.close();
     return exists;
@@ -1221,6 +1280,7 @@ void CardReader::fileHasFinished() {
   void CardReader::removeJobRecoveryFile() {
     if (jobRecoverFileExists()) {
       recovery.init();
+      recovery.close();
       removeFile(recovery.filename);
       #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
         SERIAL_ECHOPGM("Power-loss file delete");
@@ -1229,6 +1289,49 @@ void CardReader::fileHasFinished() {
     }
   }
 
+  #if ENABLED(POWER_LOSS_JOURNAL)
+
+    /**
+     * Open the power-loss journal, to stay open for the job. A file that isn't
+     * a contiguous journal of the configured size is replaced with a new one,
+     * zeroed so no record of an old file left on the card can be taken for new.
+     * Return the first block of the file, or 0 on failure.
+     */
+    uint32_t CardReader::openJobRecoveryJournal(bool &fresh) {
+      constexpr uint32_t size = POWER_LOSS_JOURNAL_SLOTS * 512UL;
+      uint32_t first, last;
+      fresh = false;
+      if (!isMounted()) return 0;
+      if (recovery.file.isOpen() || recovery.file.open(&root, recovery.filename, O_READ)) {
+        if (recovery.file.fileSize() == size && recovery.file.contiguousRange(&first, &last)) return first;
+        recovery.file.close();
+        removeFile(recovery.filename);
+      }
+      if (!recovery.file.createContiguous(&root, recovery.filename, size) || !recovery.file.contiguousRange(&first, &last)) {
+        SERIAL_ECHOLNPAIR(STR_SD_OPEN_FILE_FAIL, recovery.filename, ".");
+        return 0;
+      }
+      for (uint32_t b = first; b <= last; b++)
+        if (!writeJobRecoveryBlock(b, nullptr, 0)) return 0;
+      fresh = true;
+      return first;
+    }
+
+    /**
+     * Write a block of the journal to the card, from the volume's block cache,
+     * which is then left empty. The FAT and directory are untouched. With
+     * SD_WRITE_BEHIND the block waits in the queue like any other.
+     */
+    bool CardReader::writeJobRecoveryBlock(const uint32_t block, const void * const data, const uint16_t len) {
+      cache_t * const c = volume.cacheClear();
+      if (!c) return false;
+      if (len) memcpy(c->data, data, len);
+      memset(c->data + len, 0, 512 - len);
+      return TERN(SD_WRITE_BEHIND, SdWriteQueue::write(&sd2card, block, c->data), sd2card.writeBlock(block, c->data));
+    }
+
+  #endif
+
 #endif // POWER_LOSS_RECOVERY
 
 #endif // SDSUPPORT
@@ -196,6 +196,10 @@ public:
     static bool jobRecoverFileExists();
     static void openJobRecoveryFile(const bool read);
     static void removeJobRecoveryFile();
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      static uint32_t openJobRecoveryJournal(bool &fresh);
+      static bool writeJobRecoveryBlock(const uint32_t block, const void * const data, const uint16_t len);
+    #endif
   #endif
 
   static inline bool isFileOpen() { return isMounted() && file.isOpen(); }
@@ -208,6 +212,13 @@ public:
   static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
   static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
 
+  #if ENABLED(SD_READ_AHEAD)
+    // The buffered bytes from sdpos to the end of its block. nullptr at EOF or on a read error.
+    static const char* read_ahead(uint16_t &len);
+    static inline void consume(const uint16_t n) { sdpos += n; }
+    static void prefetch();
+  #endif
+
   static Sd2Card& getSd2Card() { return sd2card; }
 
   #if ENABLED(AUTO_REPORT_SD_STATUS)
@@ -292,9 +303,25 @@ private:
   static Sd2Card sd2card;
   static SdVolume volume;
   static SdFile file;
+  #ifdef SD_FILE_EXTENTS
+    static SdExtents fileExtents;   // Cluster runs of the file being read
+  #endif
 
   static uint32_t filesize, sdpos;
 
+  //
+  // Read-ahead for printing. Two whole blocks of the file, at 512-byte offsets.
+  //
+  #if ENABLED(SD_READ_AHEAD)
+    typedef struct {
+      uint32_t start;   // File offset of the block
+      uint16_t len;     // Bytes held. 0 = empty.
+      char data[512];
+    } read_ahead_t;
+    static read_ahead_t ahead[2];
+    static bool fill_ahead(read_ahead_t &b, const uint32_t start);
+  #endif
+
   //
   // Procedure calls to other files
   //
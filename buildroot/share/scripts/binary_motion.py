@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Encode a G-code file for BINARY_MOTION_PROTOCOL.
+
+The output starts with "N1 M576 S1", which switches the port to binary, then
+holds frames numbered N2, N3... Each G0/G1 with only X Y Z E F words becomes a
+move record, with X Y Z as µm deltas, E as 10 nm deltas and F in whole mm/min.
+Any other line, or a move that doesn't fit those units, is sent as a text
+record. The last frame ends binary mode.
+
+This is a reference for hosts. The output can be sent as-is over a link with
+no flow control (or run with the simulator's --replay), and the sizes of the
+binary and numbered ASCII streams are printed for comparison.
+"""
+
+import argparse
+import re
+import sys
+
+SYNC, ESC = 0xC0, 0xDB
+REC_G1, REC_G0, REC_TEXT, REC_END = range(4)
+WORDS = 'XYZEF'
+SCALE = { 'X': 1000, 'Y': 1000, 'Z': 1000, 'E': 100000, 'F': 1 }
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('input', help='G-code file')
+parser.add_argument('-o', '--output', help='binary stream (default=<input>.bin)')
+parser.add_argument('--ascii', help='also write the same commands as numbered ASCII lines')
+parser.add_argument('--frame', type=int, default=64, help='BINARY_MOTION_FRAME_SIZE (default=64)')
+parser.add_argument('--baud', type=int, default=250000, help='baud rate for the moves/s estimate (default=250000)')
+args = parser.parse_args()
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = (crc << 1 ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+def varint(v):
+    out = bytearray()
+    while True:
+        out.append(v & 0x7F | (0x80 if v > 0x7F else 0))
+        v >>= 7
+        if not v: return out
+
+def zigzag(n):
+    return n << 1 if n >= 0 else (-n << 1) - 1
+
+def numbered(n, cmd):
+    line = 'N%d %s' % (n, cmd)
+    cs = 0
+    for c in line.encode(): cs ^= c
+    return '%s*%d\n' % (line, cs)
+
+def clean(line):
+    line = re.sub(r'\(.*?\)', '', line.split(';')[0])
+    return ' '.join(line.split())
+
+last = { w: 0 for w in WORDS }
+
+def move_record(cmd):
+    """A move record for a G0/G1 line, or None if it needs text."""
+    parts = cmd.upper().split(' ')
+    if parts[0] not in ('G0', 'G1', 'G00', 'G01'): return None
+    values = {}
+    for p in parts[1:]:
+        if len(p) < 2 or p[0] not in WORDS or p[0] in values: return None
+        try:
+            v = float(p[1:]) * SCALE[p[0]]
+        except ValueError:
+            return None
+        iv = round(v)
+        if abs(v - iv) > 1e-6 or not -2**31 <= iv < 2**31: return None
+        if p[0] == 'F' and iv < 0: return None
+        values[p[0]] = iv
+    rec = bytearray([REC_G0 if parts[0] in ('G0', 'G00') else REC_G1])
+    for i, w in enumerate(WORDS):
+        if w not in values: continue
+        rec[0] |= 1 << (i + 2)
+        if w == 'F':
+            rec += varint(values[w])
+        else:
+            delta = values[w] - last[w]
+            if not -2**31 <= delta < 2**31: return None
+            rec += varint(zigzag(delta))
+    for w, v in values.items(): last[w] = v
+    return rec
+
+def text_record(cmd):
+    data = cmd.encode()
+    if not 0 < len(data) < 96: sys.exit('Line too long: ' + cmd)
+    return bytearray([REC_TEXT, len(data)]) + data
+
+def frame(n, payload):
+    body = bytearray([n & 0xFF, len(payload)]) + payload
+    crc = crc16(body)
+    body += bytearray([crc & 0xFF, crc >> 8])
+    out = bytearray([SYNC])
+    for b in body:
+        if b in (SYNC, ESC, 0x0A, 0x0D):
+            out += bytearray([ESC, b ^ 0x20])
+        else:
+            out.append(b)
+    return out
+
+with open(args.input) as f:
+    commands = [c for c in map(clean, f) if c]
+
+binary = bytearray(numbered(1, 'M576 S1').encode())
+ascii_lines = []
+n, payload, moves, texts = 2, bytearray(), 0, 0
+for cmd in commands:
+    rec = move_record(cmd)
+    if rec is None:
+        rec = text_record(cmd)
+        texts += 1
+    else:
+        moves += 1
+    ascii_lines.append(cmd)
+    if len(payload) + len(rec) > args.frame:
+        binary += frame(n, payload)
+        n += 1
+        payload = bytearray()
+    payload += rec
+
+if len(payload) + 1 > args.frame:
+    binary += frame(n, payload)
+    n += 1
+    payload = bytearray()
+binary += frame(n, payload + bytearray([REC_END]))
+
+with open(args.output or args.input + '.bin', 'wb') as f:
+    f.write(binary)
+
+ascii_size = sum(len(numbered(i + 1, c)) for i, c in enumerate(ascii_lines))
+if args.ascii:
+    with open(args.ascii, 'w') as f:
+        for i, c in enumerate(ascii_lines): f.write(numbered(i + 1, c))
+
+bytes_per_s = args.baud / 10
+print('%d moves, %d text lines, %d frames' % (moves, texts, n - 1))
+print('ASCII:  %8d bytes, %7.0f moves/s at %d baud' % (ascii_size, moves * bytes_per_s / ascii_size, args.baud))
+print('Binary: %8d bytes, %7.0f moves/s at %d baud (%.2fx)' % (len(binary), moves * bytes_per_s / len(binary), args.baud, ascii_size / len(binary)))
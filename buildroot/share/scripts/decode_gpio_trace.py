@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""
+Decode a binary GPIO trace from the LINUX simulator (GPIO_LOGGING in
+Marlin/src/HAL/LINUX/main.cpp) into per-axis step timelines.
+
+Writes <prefix>_<axis>.csv for each traced axis with one "time_ns,position"
+row per step. Positions are relative to the start of the trace.
+"""
+
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct('<8sIIQQII')  # magic, version, record_size, record_count, dropped, axis_count, reserved
+AXIS = struct.Struct('<cBhhh')       # name, reserved, step_pin, dir_pin, enable_pin
+RECORD = struct.Struct('<QhHB3x')    # timestamp, pin, value, event
+MAX_AXES = 8
+RECORDS_OFFSET = 4096
+EVENT_RISE = 2
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('trace', help='trace file (default name gpio_trace.bin)')
+parser.add_argument('-o', '--prefix', default='steps', help='output file prefix (default=steps)')
+args = parser.parse_args()
+
+with open(args.trace, 'rb') as f:
+    magic, version, record_size, record_count, dropped, axis_count, _ = HEADER.unpack(f.read(HEADER.size))
+    if magic != b'MLNTRACE' or version != 1 or record_size != RECORD.size:
+        sys.exit("%s: not a version 1 GPIO trace" % args.trace)
+
+    axes = []
+    for i in range(MAX_AXES):
+        name, _, step_pin, dir_pin, enable_pin = AXIS.unpack(f.read(AXIS.size))
+        if i < axis_count:
+            axes.append({ 'name': name.decode(), 'step': step_pin, 'dir': dir_pin, 'enable': enable_pin, 'position': 0, 'steps': 0 })
+
+    by_step_pin = { axis['step']: axis for axis in axes }
+    pin_value = {}
+    outputs = { axis['name']: open('%s_%s.csv' % (args.prefix, axis['name']), 'w') for axis in axes }
+    for out in outputs.values():
+        out.write('time_ns,position\n')
+
+    f.seek(RECORDS_OFFSET)
+    remaining = record_count
+    while remaining:
+        count = min(remaining, 65536)
+        block = f.read(count * RECORD.size)
+        if len(block) < count * RECORD.size:
+            sys.exit("%s: truncated trace" % args.trace)
+        for timestamp, pin, value, event in RECORD.iter_unpack(block):
+            pin_value[pin] = value
+            axis = by_step_pin.get(pin)
+            # Same rule as the simulated LinearAxis: count rising edges while enabled (active low)
+            if axis and event == EVENT_RISE and not pin_value.get(axis['enable'], 0):
+                axis['position'] += 1 if pin_value.get(axis['dir'], 0) else -1
+                axis['steps'] += 1
+                outputs[axis['name']].write('%d,%d\n' % (timestamp, axis['position']))
+        remaining -= count
+
+for out in outputs.values():
+    out.close()
+
+print("%d records, %d dropped" % (record_count, dropped))
+for axis in axes:
+    print("%s: %d steps, final position %d" % (axis['name'], axis['steps'], axis['position']))
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+Make a FAT32 disk image for the LINUX simulator's SD card (--sd-image).
+
+The image has an MBR with one FAT32 partition, as a card from the shop has.
+Files and directories named on the command line are copied to its root,
+with long names where they don't fit 8.3. With --fragment N the files are
+laid out in runs of N clusters taken in turn, so reads must follow the FAT
+from run to run like on a well-used card.
+
+  make_sd_image.py sd.img print.gcode "Long Name.gcode" models/
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('image', help='image file to write')
+parser.add_argument('files', nargs='*', help='files and directories to copy to the root')
+parser.add_argument('--size', type=int, default=64, help='image size in MB (default=64)')
+parser.add_argument('--cluster', type=int, default=1, choices=[1, 2, 4, 8, 16, 32, 64], help='blocks per cluster (default=1)')
+parser.add_argument('--fragment', type=int, default=0, help='lay files out in interleaved runs of this many clusters')
+args = parser.parse_args()
+
+SECTOR, START, RESERVED, FATS = 512, 2048, 32, 2
+total = args.size * 1024 * 1024 // SECTOR - START
+spc = args.cluster
+
+# The FAT must cover the clusters left after the FAT itself
+fat_sectors = 1
+while True:
+    clusters = (total - RESERVED - FATS * fat_sectors) // spc
+    need = ((clusters + 2) * 4 + SECTOR - 1) // SECTOR
+    if need <= fat_sectors: break
+    fat_sectors = need
+if clusters < 65525:
+    sys.exit('%d clusters is too few for FAT32. Use a bigger --size or smaller --cluster.' % clusters)
+
+data_start = RESERVED + FATS * fat_sectors
+cluster_bytes = spc * SECTOR
+fat = [0x0FFFFFF8, 0x0FFFFFFF]
+data = {}                                   # cluster -> bytes
+
+def fat_time(t):
+    lt = time.localtime(max(t, 315532800))  # FAT dates start at 1980
+    return ((lt.tm_year - 1980) << 9 | lt.tm_mon << 5 | lt.tm_mday,
+            lt.tm_hour << 11 | lt.tm_min << 5 | lt.tm_sec // 2)
+
+def allocate(count):
+    first = len(fat)
+    fat.extend(range(first + 1, first + count))
+    fat.append(0x0FFFFFFF)
+    return list(range(first, first + count))
+
+def chain(clusters):
+    for a, b in zip(clusters, clusters[1:]): fat[a] = b
+    fat[clusters[-1]] = 0x0FFFFFFF
+
+def store(clusters, content):
+    for i, c in enumerate(clusters):
+        data[c] = content[i * cluster_bytes:(i + 1) * cluster_bytes]
+
+VALID83 = set('ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789$%\'-_@~`!(){}^#&')
+
+def short_name(name, used):
+    """The 8.3 name of 'name', and whether it needs a long name too"""
+    base, ext = (name.rsplit('.', 1) + [''])[:2] if '.' in name[1:] else (name, '')
+    if 0 < len(base) <= 8 and len(ext) <= 3 and set((base + ext).upper()) <= VALID83:
+        sn = (base.upper().ljust(8) + ext.upper().ljust(3)).encode()
+        if sn not in used: return sn, name != name.upper()   # A long name keeps the case
+    clean = lambda s: ''.join(c if c in VALID83 else '_' for c in s.upper().replace(' ', '').replace('.', ''))
+    b, e = clean(base) or '_', clean(ext)[:3]
+    for n in range(1, 1000000):
+        tail = '~%d' % n
+        sn = (b[:8 - len(tail)] + tail).ljust(8).encode() + e.ljust(3).encode()
+        if sn not in used: return sn, True
+    sys.exit('Too many files like ' + name)
+
+def entry(sn, attr, cluster, size, mtime):
+    d, t = fat_time(mtime)
+    return struct.pack('<11sBBBHHHHHHHI', sn, attr, 0, 0, t, d, d, cluster >> 16, t, d, cluster & 0xFFFF, size)
+
+def lfn_entries(name, sn):
+    cs = 0
+    for c in sn: cs = (((cs & 1) << 7) + (cs >> 1) + c) & 0xFF
+    chars = [ord(c) for c in name]
+    if len(chars) % 13: chars.append(0)     # Terminated unless it fills the last entry
+    chars += [0xFFFF] * (-len(chars) % 13)
+    parts = [chars[i:i + 13] for i in range(0, len(chars), 13)]
+    out = []
+    for n in range(len(parts), 0, -1):      # Stored last part first
+        p = parts[n - 1]
+        out.append(struct.pack('<B10sBBB12sH4s', n | (0x40 if n == len(parts) else 0),
+                               struct.pack('<5H', *p[:5]), 0x0F, 0, cs,
+                               struct.pack('<6H', *p[5:11]), 0, struct.pack('<2H', *p[11:13])))
+    return out
+
+dirs = []                                   # (clusters, entries) to write once the files are placed
+files = []                                  # (entries, index, content) waiting for their clusters
+
+def add_dir(names, base, parent, clusters):
+    entries, used = [], set()
+    if parent is not None:
+        now = time.time()
+        entries += [entry(b'.'.ljust(11), 0x10, clusters[0], 0, now), entry(b'..'.ljust(11), 0x10, parent, 0, now)]
+    for name in names:
+        src = os.path.join(base, name)
+        leaf = os.path.basename(os.path.normpath(name))
+        sn, long = short_name(leaf, used)
+        used.add(sn)
+        if long: entries += lfn_entries(leaf, sn)
+        st = os.stat(src)
+        if os.path.isdir(src):
+            sub = allocate(1)
+            entries.append(entry(sn, 0x10, sub[0], 0, st.st_mtime))
+            add_dir(sorted(os.listdir(src)), src, 0 if parent is None else clusters[0], sub)  # ".." of a root child is 0
+        else:
+            content = open(src, 'rb').read()
+            files.append((entries, len(entries), content))
+            entries.append(entry(sn, 0x20, 0, len(content), st.st_mtime))
+    # Grow the directory as it needs to, one cluster at a time
+    while len(entries) * 32 > len(clusters) * cluster_bytes:
+        clusters += allocate(1)
+        chain(clusters)
+    dirs.append((clusters, entries))
+
+root = allocate(1)
+add_dir(args.files, '', None, root)
+
+# Place the files, one after another or in interleaved runs
+runs = [[] for _ in files]
+left = [(len(f[2]) + cluster_bytes - 1) // cluster_bytes for f in files]
+step = args.fragment or max(left + [1])
+while any(left):
+    for i, n in enumerate(left):
+        take = min(n, step)
+        if take:
+            runs[i] += allocate(take)
+            left[i] -= take
+for (entries, idx, content), fc in zip(files, runs):
+    if not fc: continue
+    chain(fc)
+    store(fc, content)
+    e = entries[idx]
+    entries[idx] = e[:20] + struct.pack('<H', fc[0] >> 16) + e[22:26] + struct.pack('<H', fc[0] & 0xFFFF) + e[28:]
+for dc, entries in dirs:
+    store(dc, b''.join(entries))
+
+if len(fat) > clusters + 2:
+    sys.exit('The files need %d clusters and the image holds %d' % (len(fat) - 2, clusters))
+
+free = clusters + 2 - len(fat)
+mbr = bytearray(SECTOR)
+mbr[446:462] = struct.pack('<B3sB3sII', 0, b'\xfe\xff\xff', 0x0C, b'\xfe\xff\xff', START, total)
+mbr[510:512] = b'\x55\xaa'
+
+boot = bytearray(SECTOR)
+boot[0:90] = struct.pack('<3s8sHBHBHHBHHHIIIHHIHH12sBBBI11s8s',
+    b'\xeb\x58\x90', b'MARLIN  ', SECTOR, spc, RESERVED, FATS, 0, 0, 0xF8, 0, 63, 255, START, total,
+    fat_sectors, 0, 0, root[0], 1, 6, bytes(12), 0x80, 0, 0x29, 0x12345678, b'MARLIN SD  ', b'FAT32   ')
+boot[510:512] = b'\x55\xaa'
+
+fsinfo = bytearray(SECTOR)
+struct.pack_into('<I', fsinfo, 0, 0x41615252)
+struct.pack_into('<III', fsinfo, 484, 0x61417272, free, len(fat))
+fsinfo[510:512] = b'\x55\xaa'
+
+fat += [0] * (clusters + 2 - len(fat))
+fat_bytes = struct.pack('<%dI' % len(fat), *fat)
+
+with open(args.image, 'wb') as f:
+    f.truncate((START + total) * SECTOR)    # Sparse where nothing is written
+    def put(sector, b):
+        f.seek((START + sector) * SECTOR)
+        f.write(b)
+    f.seek(0); f.write(mbr)
+    for s in (0, 6): put(s, boot); put(s + 1, fsinfo)
+    for n in range(FATS): put(RESERVED + n * fat_sectors, fat_bytes)
+    for c, b in sorted(data.items()):
+        put(data_start + (c - 2) * spc, b)
+
+used = len([c for c in fat[2:] if c])
+print('%s: FAT32, %d MB, %d clusters of %d bytes, %d used' % (args.image, args.size, clusters, cluster_bytes, used))
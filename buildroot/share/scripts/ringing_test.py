@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Generate a ringing tower to tune INPUT_SHAPING.
+
+Prints a thin-walled square tower with fast, sharp corners. Ripples appear on
+the walls after each corner. With --sweep the tower is cut into bands, each
+with the shaper set to the next frequency (M593 F), so the band where the
+ripples disappear gives the resonance. Without --sweep shaping is turned off
+(M593 F0) and the ripple spacing gives the frequency:
+
+  frequency = print speed / distance between ripples
+
+X resonance shows on the walls parallel to X, Y resonance on the walls parallel to Y.
+"""
+
+import argparse
+import math
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('-o', '--output', default='ringing_test.gcode', help='output file (default=ringing_test.gcode)')
+parser.add_argument('--size', type=float, default=60, help='tower side in mm (default=60)')
+parser.add_argument('--height', type=float, default=30, help='tower height in mm (default=30)')
+parser.add_argument('--center', type=float, nargs=2, default=(100, 100), metavar=('X', 'Y'), help='tower center (default=100 100)')
+parser.add_argument('--layer', type=float, default=0.2, help='layer height in mm (default=0.2)')
+parser.add_argument('--width', type=float, default=0.45, help='extrusion width in mm (default=0.45)')
+parser.add_argument('--filament', type=float, default=1.75, help='filament diameter in mm (default=1.75)')
+parser.add_argument('--speed', type=float, default=100, help='wall speed in mm/s (default=100)')
+parser.add_argument('--accel', type=float, default=7000, help='acceleration in mm/s² (default=7000)')
+parser.add_argument('--jerk', type=float, default=10, help='XY jerk in mm/s (default=10)')
+parser.add_argument('--hotend', type=int, default=210, help='hotend temperature (default=210)')
+parser.add_argument('--bed', type=int, default=60, help='bed temperature (default=60)')
+parser.add_argument('--type', type=int, default=0, choices=(0, 1, 2), help='shaper: 0=ZV 1=ZVD 2=EI (default=0)')
+parser.add_argument('--zeta', type=float, default=0.1, help='damping ratio for the sweep (default=0.1)')
+parser.add_argument('--sweep', type=float, nargs=3, metavar=('START', 'END', 'STEP'),
+                    help='shaper frequencies in Hz, one band each')
+args = parser.parse_args()
+
+e_per_mm = args.width * args.layer / (math.pi * (args.filament / 2) ** 2)
+layers = int(round(args.height / args.layer))
+
+bands = []
+if args.sweep:
+    start, end, step = args.sweep
+    count = int(math.floor((end - start) / step + 1e-6)) + 1
+    bands = [start + i * step for i in range(count)]
+
+cx, cy = args.center
+h = args.size / 2
+corners = [(cx - h, cy - h), (cx + h, cy - h), (cx + h, cy + h), (cx - h, cy + h)]
+
+with open(args.output, 'w') as out:
+    w = out.write
+    w('; Ringing tower: %gmm at %gmm/s, %gmm/s² accel\n' % (args.size, args.speed, args.accel))
+    w('M140 S%d\nM104 S%d\nG28\nM190 S%d\nM109 S%d\n' % (args.bed, args.hotend, args.bed, args.hotend))
+    w('G90\nM83\nM201 X%d Y%d\nM204 P%d T%d\nM205 X%g Y%g\n' % (args.accel, args.accel, args.accel, args.accel, args.jerk, args.jerk))
+    if not bands:
+        w('M593 F0 ; Shaping off, measure the ripples\n')
+    band_layers = layers // len(bands) if bands else 0
+
+    for layer in range(layers):
+        z = (layer + 1) * args.layer
+        w(';LAYER:%d\n' % layer)
+        if bands and layer % band_layers == 0 and layer // band_layers < len(bands):
+            f = bands[layer // band_layers]
+            w('M593 F%g D%g T%d ; Band from Z%.2f\n' % (f, args.zeta, args.type, z))
+        # Slow first layer, then full speed
+        speed = args.speed if layer else min(args.speed, 30)
+        w('G1 Z%.3f F600\n' % z)
+        w('G1 X%.3f Y%.3f F6000\n' % corners[0])
+        for i in range(1, 5):
+            x0, y0 = corners[i - 1]
+            x1, y1 = corners[i % 4]
+            w('G1 X%.3f Y%.3f E%.5f F%d\n' % (x1, y1, math.hypot(x1 - x0, y1 - y0) * e_per_mm, speed * 60))
+
+    w('M104 S0\nM140 S0\nG91\nG1 Z10 F600\nG90\nM84\n')
+
+print('Wrote %s: %d layers%s' % (args.output, layers,
+      ', bands at ' + ' '.join('%gHz' % f for f in bands) if bands else ''))
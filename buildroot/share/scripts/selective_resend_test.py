@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Check SELECTIVE_RESEND against the LINUX simulator.
+
+A windowed host streams numbered "M118 L<n>" lines, keeping up to --window
+lines waiting for their "ok". One line goes out with a bad checksum and one
+is not sent at all. The test passes if the firmware asks for those two lines
+and no others, each once, and echoes every line exactly once and in order.
+
+  selective_resend_test.py .pio/build/linux_native/program
+"""
+
+import argparse
+import select
+import subprocess
+import sys
+import time
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument('program', help='simulator built with SELECTIVE_RESEND')
+parser.add_argument('--lines', type=int, default=40, help='lines to send (default=40)')
+parser.add_argument('--window', type=int, default=4, help='RESEND_WINDOW (default=4)')
+parser.add_argument('--corrupt', type=int, default=5, help='line sent with a bad checksum (default=5)')
+parser.add_argument('--drop', type=int, default=23, help='line not sent the first time (default=23)')
+parser.add_argument('--timeout', type=float, default=20, help='seconds (default=20)')
+args = parser.parse_args()
+if not 0 < args.drop < args.lines:
+    parser.error('--drop must come before the last line, or nothing shows it was lost')
+
+def numbered(n, cmd, bad=False):
+    line = 'N%d %s' % (n, cmd)
+    cs = 0
+    for c in line.encode(): cs ^= c
+    return '%s*%d\n' % (line, cs ^ 1 if bad else cs)
+
+sim = subprocess.Popen([args.program, '--virtual-time'], stdin=subprocess.PIPE, stdout=subprocess.PIPE, bufsize=0)
+
+def send(text):
+    sim.stdin.write(text.encode())
+    sim.stdin.flush()
+
+pending = b''
+def read_lines(wait):
+    global pending
+    out = []
+    if select.select([sim.stdout], [], [], wait)[0]:
+        data = sim.stdout.read1(4096) if hasattr(sim.stdout, 'read1') else sim.stdout.read(4096)
+        if not data: raise SystemExit('simulator exited')
+        pending += data
+        *done, pending = pending.split(b'\n')
+        out = [l.decode(errors='replace').strip() for l in done]
+    return out
+
+deadline = time.time() + args.timeout
+
+# M110 sets the line number when it runs, so wait for its "ok" like a host does
+send(numbered(0, 'M110 N0'))
+while not any(l.startswith('ok') for l in read_lines(0.1)):
+    if time.time() > deadline: raise SystemExit('no "ok" for M110')
+
+next_n, in_flight, resends, echoes = 1, 0, [], []
+failed = set([args.corrupt, args.drop])
+
+while len(echoes) < args.lines and time.time() < deadline:
+    # Keep the window full
+    while next_n <= args.lines and in_flight < args.window:
+        if next_n == args.drop and next_n in failed:
+            failed.discard(next_n)            # Lost on the way
+        else:
+            bad = next_n == args.corrupt and next_n in failed
+            failed.discard(next_n)
+            send(numbered(next_n, 'M118 L%d' % next_n, bad))
+        in_flight += 1
+        next_n += 1
+
+    for line in read_lines(0.1):
+        if line.startswith('ok'):
+            in_flight -= 1
+        elif line.startswith('Resend:'):
+            n = int(line.split(':')[1])
+            resends.append(n)
+            send(numbered(n, 'M118 L%d' % n))
+            if n != args.drop: in_flight += 1   # A bad line got an "ok" with its error, a lost one didn't
+        elif line.startswith('L'):
+            echoes.append(int(line[1:]))
+
+sim.kill()
+
+expected = list(range(1, args.lines + 1))
+print('resends:', resends)
+ok = sorted(resends) == sorted([args.corrupt, args.drop]) and echoes == expected
+if echoes != expected:
+    print('echoes:', echoes)
+print('PASS' if ok else 'FAIL')
+sys.exit(0 if ok else 1)